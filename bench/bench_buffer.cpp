@@ -3,6 +3,7 @@
 #include <vector>
 #include <cstring>
 #include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
 
 static void BM_Buffer_EncodedLength_Small(benchmark::State& state) {
     std::vector<uint8_t> data(16);
@@ -292,6 +293,199 @@ static void BM_Buffer_Roundtrip_ASCII_Large(benchmark::State& state) {
     state.SetBytesProcessed(state.iterations() * data.size());
 }
 
+// Fill [data] with pseudo-random non-special bytes, with one END/ESC byte
+// per [permille] thousand bytes on average (0 = no special bytes at all)
+static void fill_with_density(std::vector<uint8_t>& data, int64_t permille) {
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < data.size(); i++) {
+        state = state * 1664525u + 1013904223u;
+        uint8_t b = static_cast<uint8_t>(state >> 24);
+        if (b == 0xC0 || b == 0xDB) {
+            b = 0x42;
+        }
+        if (permille > 0 && static_cast<int64_t>((state >> 8) % 1000) < permille) {
+            b = (state & 1) ? 0xC0 : 0xDB;
+        }
+        data[i] = b;
+    }
+}
+
+// Per-byte reference encoder (the pre-vectorization algorithm), used as a
+// baseline to show the speedup of SLIPStream::encode_packet() at each density
+static size_t encode_packet_bytewise(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+    uint8_t* out_start = out;
+    uint8_t* outend = out + outlen;
+    for (const uint8_t* inend = in + inlen; in < inend; in++) {
+        if (*in == 0xC0 || *in == 0xDB) {
+            if (out + 2 >= outend) {
+                return SLIPStream::ENCODE_ERROR;
+            }
+            *out++ = 0xDB;
+            *out++ = (*in == 0xC0) ? 0xDC : 0xDD;
+        } else {
+            if (out + 1 >= outend) {
+                return SLIPStream::ENCODE_ERROR;
+            }
+            *out++ = *in;
+        }
+    }
+    *out++ = 0xC0;
+    return out - out_start;
+}
+
+// Args: payload size, special bytes per 1000 payload bytes
+static void BM_Buffer_Encode_Density(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    fill_with_density(data, state.range(1));
+    std::vector<uint8_t> out(2 * data.size() + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::encode_packet(data.data(), data.size(), out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_Buffer_Encode_Density_Bytewise(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    fill_with_density(data, state.range(1));
+    std::vector<uint8_t> out(2 * data.size() + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_packet_bytewise(data.data(), data.size(), out.data(), out.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// Documented two-pass pattern: encoded_length() to size the buffer, then encode_packet()
+static void BM_Buffer_Encode_TwoPass(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    fill_with_density(data, state.range(1));
+    std::vector<uint8_t> out(2 * data.size() + 1);
+    for (auto _ : state) {
+        size_t len = SLIPStream::encoded_length(data.data(), data.size());
+        benchmark::DoNotOptimize(SLIPStream::encode_packet(data.data(), data.size(), out.data(), len));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// Single pass into a worst-case sized buffer
+static void BM_Buffer_Encode_Max(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    fill_with_density(data, state.range(1));
+    std::vector<uint8_t> out(SLIPStream::max_encoded_length(data.size()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::encode_packet_max(data.data(), data.size(), out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// payload + CRC32 the old way: append_crc32() into a buffer with spare capacity, then encode_packet()
+static void BM_Buffer_EncodeCrc32_AppendThenEncode(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0) + 4);
+    std::vector<uint8_t> payload(state.range(0));
+    fill_with_density(payload, state.range(1));
+    std::vector<uint8_t> out(SLIPStream::max_encoded_length_crc32(payload.size()));
+    for (auto _ : state) {
+        memcpy(data.data(), payload.data(), payload.size());
+        size_t len = SLIPStream::append_crc32(data.data(), payload.size());
+        benchmark::DoNotOptimize(SLIPStream::encode_packet(data.data(), len, out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+// payload + CRC32 computed while escaping
+static void BM_Buffer_EncodeCrc32_Fused(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0));
+    fill_with_density(payload, state.range(1));
+    std::vector<uint8_t> out(SLIPStream::max_encoded_length_crc32(payload.size()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::encode_packet_crc32(payload.data(), payload.size(), out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+// payload + CRC32 the old way: decode_packet(), then verify_crc32()
+static void BM_Buffer_DecodeCrc32_DecodeThenVerify(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0));
+    fill_with_density(payload, state.range(1));
+    std::vector<uint8_t> encoded(SLIPStream::max_encoded_length_crc32(payload.size()));
+    size_t enc_len = SLIPStream::encode_packet_crc32(payload.data(), payload.size(), encoded.data(), encoded.size());
+    std::vector<uint8_t> out(payload.size() + 4);
+    for (auto _ : state) {
+        size_t len = SLIPStream::decode_packet(encoded.data(), enc_len, out.data(), out.size());
+        benchmark::DoNotOptimize(SLIPStream::verify_crc32(out.data(), len));
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+// payload + CRC32 verified while unescaping
+static void BM_Buffer_DecodeCrc32_Fused(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0));
+    fill_with_density(payload, state.range(1));
+    std::vector<uint8_t> encoded(SLIPStream::max_encoded_length_crc32(payload.size()));
+    size_t enc_len = SLIPStream::encode_packet_crc32(payload.data(), payload.size(), encoded.data(), encoded.size());
+    std::vector<uint8_t> out(payload.size() + 4);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::decode_packet_crc32(encoded.data(), enc_len, out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+static void EncodeDensityArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {256, 4096}) {
+        for (int64_t permille : {0, 1, 10, 100, 500}) {
+            b->Args({size, permille});
+        }
+    }
+}
+
+// One receive buffer holding many small frames, walked using the consumed count
+static void BM_Buffer_Decode_MultiFrame(benchmark::State& state) {
+    std::vector<uint8_t> frame(state.range(0));
+    fill_with_density(frame, 10);
+    std::vector<uint8_t> encoded(2 * frame.size() + 1);
+    size_t enc_len = SLIPStream::encode_packet(frame.data(), frame.size(), encoded.data(), encoded.size());
+    std::vector<uint8_t> rx;
+    for (int i = 0; i < 64; i++) {
+        rx.insert(rx.end(), encoded.begin(), encoded.begin() + enc_len);
+    }
+    std::vector<uint8_t> out(frame.size());
+    for (auto _ : state) {
+        const uint8_t* in = rx.data();
+        size_t inlen = rx.size();
+        while (inlen > 0) {
+            size_t consumed;
+            size_t len = SLIPStream::decode_packet(in, inlen, out.data(), out.size(), &consumed);
+            if (len == SLIPStream::DECODE_ERROR) {
+                break;
+            }
+            benchmark::DoNotOptimize(len);
+            in += consumed;
+            inlen -= consumed;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * rx.size());
+}
+
+// Same receive buffer as BM_Buffer_Decode_MultiFrame, decoded into a frame index in one call
+static void BM_Buffer_DecodeAll_MultiFrame(benchmark::State& state) {
+    std::vector<uint8_t> frame(state.range(0));
+    fill_with_density(frame, 10);
+    std::vector<uint8_t> encoded(2 * frame.size() + 1);
+    size_t enc_len = SLIPStream::encode_packet(frame.data(), frame.size(), encoded.data(), encoded.size());
+    std::vector<uint8_t> rx;
+    for (int i = 0; i < 64; i++) {
+        rx.insert(rx.end(), encoded.begin(), encoded.begin() + enc_len);
+    }
+    std::vector<uint8_t> arena(rx.size());
+    std::vector<SLIPStream::FrameRef> frames(64);
+    for (auto _ : state) {
+        size_t consumed;
+        benchmark::DoNotOptimize(SLIPStream::decode_all_packets(rx.data(), rx.size(), arena.data(), arena.size(),
+                                                                frames.data(), frames.size(), &consumed));
+    }
+    state.SetBytesProcessed(state.iterations() * rx.size());
+}
+
 BENCHMARK(BM_Buffer_EncodedLength_Small);
 BENCHMARK(BM_Buffer_EncodedLength_Medium);
 BENCHMARK(BM_Buffer_EncodedLength_Large);
@@ -303,6 +497,12 @@ BENCHMARK(BM_Buffer_Encode_WithSpecialBytes);
 BENCHMARK(BM_Buffer_Encode_ASCII_Small);
 BENCHMARK(BM_Buffer_Encode_ASCII_Medium);
 BENCHMARK(BM_Buffer_Encode_ASCII_Large);
+BENCHMARK(BM_Buffer_Encode_Density)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_Encode_Density_Bytewise)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_Encode_TwoPass)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_Encode_Max)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_EncodeCrc32_AppendThenEncode)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_EncodeCrc32_Fused)->Apply(EncodeDensityArgs);
 
 BENCHMARK(BM_Buffer_Decode_Small);
 BENCHMARK(BM_Buffer_Decode_Medium);
@@ -311,6 +511,10 @@ BENCHMARK(BM_Buffer_Decode_WithSpecialBytes);
 BENCHMARK(BM_Buffer_Decode_ASCII_Small);
 BENCHMARK(BM_Buffer_Decode_ASCII_Medium);
 BENCHMARK(BM_Buffer_Decode_ASCII_Large);
+BENCHMARK(BM_Buffer_DecodeCrc32_DecodeThenVerify)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_DecodeCrc32_Fused)->Apply(EncodeDensityArgs);
+BENCHMARK(BM_Buffer_Decode_MultiFrame)->Arg(16)->Arg(128)->Arg(1024);
+BENCHMARK(BM_Buffer_DecodeAll_MultiFrame)->Arg(16)->Arg(128)->Arg(1024);
 
 BENCHMARK(BM_Buffer_Roundtrip_Small);
 BENCHMARK(BM_Buffer_Roundtrip_Medium);
@@ -3,6 +3,8 @@
 #include <vector>
 #include <cstring>
 #include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Crc.hpp"
+#include "Kernels.hpp" // CRC32 table variants
 
 static void BM_CRC32_Calculate_Small(benchmark::State& state) {
     std::vector<uint8_t> data(16);
@@ -36,6 +38,42 @@ static void BM_CRC32_Calculate_VeryLarge(benchmark::State& state) {
     state.SetBytesProcessed(state.iterations() * data.size());
 }
 
+// Throughput across lengths, covering the switch to slicing-by-8/16
+static void BM_CRC32_Calculate_Sweep(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::calculate_crc32(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// Large capture files: single-threaded vs. split across threads (range(1), 0 = all cores)
+static void BM_CRC32_Calculate_Huge(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::calculate_crc32(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_CRC32_Calculate_Parallel(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131);
+    }
+    unsigned threads = static_cast<unsigned>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::calculate_crc32_parallel(data.data(), data.size(), threads));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
 static void BM_CRC32_Append_Small(benchmark::State& state) {
     std::vector<uint8_t> data(32);
     std::vector<uint8_t> payload(16);
@@ -180,10 +218,82 @@ static void BM_CRC32_Roundtrip_Large(benchmark::State& state) {
     state.SetBytesProcessed(state.iterations() * payload.size());
 }
 
+// A batch of 64 frames of range(0) bytes: calculate_crc32() in a loop vs. calculate_crc32_batch()
+static std::vector<std::vector<uint8_t>> make_crc32_batch(size_t size) {
+    std::vector<std::vector<uint8_t>> frames(64, std::vector<uint8_t>(size));
+    for (size_t f = 0; f < frames.size(); f++) {
+        for (size_t i = 0; i < size; i++) {
+            frames[f][i] = static_cast<uint8_t>(f * 31 + i * 7);
+        }
+    }
+    return frames;
+}
+
+static void BM_CRC32_Batch_Loop(benchmark::State& state) {
+    std::vector<std::vector<uint8_t>> frames = make_crc32_batch(static_cast<size_t>(state.range(0)));
+    std::vector<uint32_t> crcs(frames.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < frames.size(); i++) {
+            crcs[i] = SLIPStream::calculate_crc32(frames[i].data(), frames[i].size());
+        }
+        benchmark::DoNotOptimize(crcs.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * frames.size() * state.range(0));
+}
+
+static void BM_CRC32_Batch(benchmark::State& state) {
+    std::vector<std::vector<uint8_t>> frames = make_crc32_batch(static_cast<size_t>(state.range(0)));
+    std::vector<const uint8_t*> bufs;
+    std::vector<size_t> lens;
+    for (const auto& frame : frames) {
+        bufs.push_back(frame.data());
+        lens.push_back(frame.size());
+    }
+    std::vector<uint32_t> crcs(frames.size());
+    for (auto _ : state) {
+        SLIPStream::calculate_crc32_batch(bufs.data(), lens.data(), crcs.data(), frames.size());
+        benchmark::DoNotOptimize(crcs.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * frames.size() * state.range(0));
+}
+
+// Portable CRC32 variants (see SLIPSTREAM_CRC32_BITWISE etc. in Kernels.hpp):
+// Throughput and the lookup table memory ("table_bytes") for range(0) bytes
+template<uint32_t (*Update)(uint32_t, const uint8_t*, size_t), size_t TableBytes>
+static void BM_CRC32_Variant(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Update(0xFFFFFFFF, data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.counters["table_bytes"] = static_cast<double>(TableBytes);
+}
+
+// Byte-wise compile-time CRC engine (Crc.hpp), range(0) is the data length
+template<typename CrcType>
+static void BM_Crc_Template(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CrcType::calculate(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
 BENCHMARK(BM_CRC32_Calculate_Small);
 BENCHMARK(BM_CRC32_Calculate_Medium);
 BENCHMARK(BM_CRC32_Calculate_Large);
 BENCHMARK(BM_CRC32_Calculate_VeryLarge);
+BENCHMARK(BM_CRC32_Calculate_Sweep)->RangeMultiplier(4)->Range(4, 1 << 20);
+BENCHMARK(BM_CRC32_Calculate_Huge)->Arg(64 << 20)->UseRealTime();
+BENCHMARK(BM_CRC32_Calculate_Parallel)->Args({64 << 20, 2})->Args({64 << 20, 4})->Args({64 << 20, 0})->UseRealTime();
 
 BENCHMARK(BM_CRC32_Append_Small);
 BENCHMARK(BM_CRC32_Append_Medium);
@@ -200,3 +310,22 @@ BENCHMARK(BM_CRC32_Extract_Large);
 BENCHMARK(BM_CRC32_Roundtrip_Small);
 BENCHMARK(BM_CRC32_Roundtrip_Medium);
 BENCHMARK(BM_CRC32_Roundtrip_Large);
+
+BENCHMARK(BM_CRC32_Batch_Loop)->Arg(32)->Arg(64)->Arg(128)->Arg(1500);
+BENCHMARK(BM_CRC32_Batch)->Arg(32)->Arg(64)->Arg(128)->Arg(1500);
+
+BENCHMARK_TEMPLATE(BM_Crc_Template, SLIPStream::Crc32)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Crc_Template, SLIPStream::Crc32C)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Crc_Template, SLIPStream::Crc16Ccitt)->Arg(16)->Arg(1024);
+
+using namespace SLIPStream::detail;
+BENCHMARK_TEMPLATE(BM_CRC32_Variant, crc32_update_bitwise, 0)->Arg(64)->Arg(1500);
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_NIBBLE
+BENCHMARK_TEMPLATE(BM_CRC32_Variant, crc32_update_nibble, CRC32_NIBBLE_TABLE_BYTES)->Arg(64)->Arg(1500);
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+BENCHMARK_TEMPLATE(BM_CRC32_Variant, crc32_update_bytewise, CRC32_BYTE_TABLE_BYTES)->Arg(64)->Arg(1500);
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+BENCHMARK_TEMPLATE(BM_CRC32_Variant, crc32_update_slicing, CRC32_SLICING_TABLE_BYTES)->Arg(64)->Arg(1500);
+#endif
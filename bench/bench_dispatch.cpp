@@ -0,0 +1,109 @@
+// Per-kernel benchmarks: Every kernel supported by the CPU is benchmarked
+// by forcing it (see SLIPStream/Dispatch.hpp), range(0) selects the kernel.
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <cstring>
+#include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Dispatch.hpp"
+
+// 1% END/ESC bytes, a typical binary payload
+static std::vector<uint8_t> make_dispatch_payload(size_t size) {
+    std::vector<uint8_t> data(size);
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < data.size(); i++) {
+        state = state * 1664525u + 1013904223u;
+        uint8_t b = static_cast<uint8_t>(state >> 24);
+        if (b == 0xC0 || b == 0xDB) {
+            b = 0x42;
+        }
+        if ((state >> 8) % 100 == 0) {
+            b = (state & 1) ? 0xC0 : 0xDB;
+        }
+        data[i] = b;
+    }
+    return data;
+}
+
+/**
+ * Force the kernel given by state.range(0)
+ * @return false (and skip the benchmark) if it is not supported by this CPU
+ */
+static bool select_kernel(benchmark::State& state) {
+    SLIPStream::Kernel kernel = static_cast<SLIPStream::Kernel>(state.range(0));
+    if (!SLIPStream::force_kernel(kernel)) {
+        state.SkipWithError("Kernel not supported on this CPU");
+        return false;
+    }
+    state.SetLabel(SLIPStream::kernel_name(kernel));
+    return true;
+}
+
+static void BM_Dispatch_EncodedLength(benchmark::State& state) {
+    if (!select_kernel(state)) return;
+    std::vector<uint8_t> data = make_dispatch_payload(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::encoded_length(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    SLIPStream::force_kernel(SLIPStream::Kernel::Auto);
+}
+
+static void BM_Dispatch_Encode(benchmark::State& state) {
+    if (!select_kernel(state)) return;
+    std::vector<uint8_t> data = make_dispatch_payload(static_cast<size_t>(state.range(1)));
+    std::vector<uint8_t> out(2 * data.size() + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::encode_packet(data.data(), data.size(), out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    SLIPStream::force_kernel(SLIPStream::Kernel::Auto);
+}
+
+static void BM_Dispatch_Decode(benchmark::State& state) {
+    if (!select_kernel(state)) return;
+    std::vector<uint8_t> data = make_dispatch_payload(static_cast<size_t>(state.range(1)));
+    std::vector<uint8_t> encoded(2 * data.size() + 1);
+    size_t enc_len = SLIPStream::encode_packet(data.data(), data.size(), encoded.data(), encoded.size());
+    std::vector<uint8_t> out(data.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::decode_packet(encoded.data(), enc_len, out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    SLIPStream::force_kernel(SLIPStream::Kernel::Auto);
+}
+
+static void BM_Dispatch_CRC32(benchmark::State& state) {
+    if (!select_kernel(state)) return;
+    std::vector<uint8_t> data = make_dispatch_payload(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::calculate_crc32(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    SLIPStream::force_kernel(SLIPStream::Kernel::Auto);
+}
+
+static void BM_Dispatch_CRC32C(benchmark::State& state) {
+    if (!select_kernel(state)) return;
+    std::vector<uint8_t> data = make_dispatch_payload(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SLIPStream::calculate_crc32c(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    SLIPStream::force_kernel(SLIPStream::Kernel::Auto);
+}
+
+static void DispatchArgs(benchmark::internal::Benchmark* b) {
+    for (SLIPStream::Kernel kernel : {SLIPStream::Kernel::Scalar, SLIPStream::Kernel::SWAR,
+                                      SLIPStream::Kernel::SSE42, SLIPStream::Kernel::AVX2}) {
+        for (int64_t size : {64, 1500, 65536}) {
+            b->Args({static_cast<int64_t>(kernel), size});
+        }
+    }
+}
+
+BENCHMARK(BM_Dispatch_EncodedLength)->Apply(DispatchArgs);
+BENCHMARK(BM_Dispatch_Encode)->Apply(DispatchArgs);
+BENCHMARK(BM_Dispatch_Decode)->Apply(DispatchArgs);
+BENCHMARK(BM_Dispatch_CRC32)->Apply(DispatchArgs);
+BENCHMARK(BM_Dispatch_CRC32C)->Apply(DispatchArgs);
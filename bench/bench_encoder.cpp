@@ -1,7 +1,10 @@
 // Encoder benchmarks
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include "SLIPStream/Encoder.hpp"
+#include "SLIPStream/BasicEncoder.hpp"
 
 static void BM_Encoder_PushPacket_Small(benchmark::State& state) {
     std::vector<uint8_t> output_buffer(1024);
@@ -221,6 +224,76 @@ static void BM_Encoder_PushPacket_ASCII_Large(benchmark::State& state) {
     state.SetBytesProcessed(state.iterations() * data.size());
 }
 
+// Queue a packet of range(0) bytes, then flush it: per-byte vs. bulk output function
+static void BM_Encoder_Flush_PerByteOutput(benchmark::State& state) {
+    std::vector<uint8_t> output_buffer(8192);
+    size_t output_index = 0;
+    auto output_fn = [&output_buffer, &output_index](uint8_t byte) -> SLIPStream::WriteStatus {
+        output_buffer[output_index++] = byte;
+        return SLIPStream::WriteStatus::Ok;
+    };
+    SLIPStream::Encoder encoder(output_fn, 8192, 0);
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x42);
+    for (auto _ : state) {
+        encoder.setMaxSendChunk(0);
+        encoder.pushPacket(data.data(), data.size());
+        encoder.setMaxSendChunk(SIZE_MAX);
+        encoder.flush();
+        output_index = 0;
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_Encoder_Flush_BulkOutput(benchmark::State& state) {
+    std::vector<uint8_t> output_buffer(8192);
+    size_t output_index = 0;
+    auto output_fn = [&output_buffer, &output_index](const uint8_t* data, size_t length) {
+        std::copy(data, data + length, output_buffer.begin() + static_cast<std::ptrdiff_t>(output_index));
+        output_index += length;
+        return std::make_pair(SLIPStream::WriteStatus::Ok, length);
+    };
+    SLIPStream::Encoder encoder(output_fn, 8192, 0);
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x42);
+    for (auto _ : state) {
+        encoder.setMaxSendChunk(0);
+        encoder.pushPacket(data.data(), data.size());
+        encoder.setMaxSendChunk(SIZE_MAX);
+        encoder.flush();
+        output_index = 0;
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// pushPacket() of range(0) bytes into a bulk sink: std::function/heap queue (Encoder)
+// vs. sink template parameter/inline queue (BasicEncoder)
+static void BM_Encoder_PushPacket_BulkOutput(benchmark::State& state) {
+    std::vector<uint8_t> output_buffer(4096);
+    auto output_fn = [&output_buffer](const uint8_t* data, size_t length) {
+        std::copy(data, data + length, output_buffer.begin());
+        return std::make_pair(SLIPStream::WriteStatus::Ok, length);
+    };
+    SLIPStream::Encoder encoder(output_fn, 4096, 256);
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x42);
+    for (auto _ : state) {
+        encoder.pushPacket(data.data(), data.size());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_BasicEncoder_PushPacket(benchmark::State& state) {
+    std::vector<uint8_t> output_buffer(4096);
+    auto output_fn = [&output_buffer](const uint8_t* data, size_t length) {
+        std::copy(data, data + length, output_buffer.begin());
+        return std::make_pair(SLIPStream::WriteStatus::Ok, length);
+    };
+    SLIPStream::BasicEncoder<decltype(output_fn), 4096> encoder(output_fn, 256);
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x42);
+    for (auto _ : state) {
+        encoder.pushPacket(data.data(), data.size());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
 BENCHMARK(BM_Encoder_PushPacket_Small);
 BENCHMARK(BM_Encoder_PushPacket_Medium);
 BENCHMARK(BM_Encoder_PushPacket_Large);
@@ -230,3 +303,7 @@ BENCHMARK(BM_Encoder_PushPacket_ASCII_Medium);
 BENCHMARK(BM_Encoder_PushPacket_ASCII_Large);
 BENCHMARK(BM_Encoder_Flush);
 BENCHMARK(BM_Encoder_MultiplePackets);
+BENCHMARK(BM_Encoder_Flush_PerByteOutput)->Arg(1024);
+BENCHMARK(BM_Encoder_Flush_BulkOutput)->Arg(1024);
+BENCHMARK(BM_Encoder_PushPacket_BulkOutput)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BM_BasicEncoder_PushPacket)->Arg(16)->Arg(256)->Arg(1024);
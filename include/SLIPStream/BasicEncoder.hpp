@@ -0,0 +1,770 @@
+/**
+ * @file BasicEncoder.hpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * Non-blocking SLIP encoder with the output sink as template parameter
+ * and an inline fixed-capacity transmit queue
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SLIPStream/SLIP.hpp"
+#include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Error.hpp"
+
+namespace SLIPStream {
+
+/**
+ * Non-blocking write status for the encoder's output callback
+ */
+enum class WriteStatus: uint8_t {
+    Ok = 0,       // Byte accepted and written
+    RetryLater = 1, // Output would block; try again later without data loss
+    Error = 2     // Non-recoverable error from output
+};
+
+/**
+ * Enhanced write status with error information
+ */
+struct WriteResult {
+    WriteStatus status;
+    ErrorInfo error;
+
+    WriteResult(WriteStatus s) : status(s), error(ErrorCode::Success) {}
+    WriteResult(ErrorCode code, size_t pos = 0, const char* msg = "")
+        : status(WriteStatus::Error), error(code, pos, msg) {}
+
+    bool is_success() const { return status == WriteStatus::Ok; }
+    bool is_retry() const { return status == WriteStatus::RetryLater; }
+    bool is_error() const { return status == WriteStatus::Error; }
+};
+
+/**
+ * Capacity argument of BasicEncoder: The queue size is given to the constructor
+ * and the queue is allocated on the heap.
+ */
+inline constexpr size_t DynamicCapacity = 0;
+
+namespace detail {
+
+/**
+ * Find the first END or ESC byte in [in, inend) using the dispatched kernel
+ * @return Pointer to the first special byte, or inend if there is none
+ */
+const uint8_t* find_special(const uint8_t* in, const uint8_t* inend);
+
+template<typename T>
+struct is_std_function : std::false_type {};
+
+template<typename R, typename... Args>
+struct is_std_function<std::function<R(Args...)>> : std::true_type {};
+
+/**
+ * Inline ring buffer storage. The capacity is a power of two, so wrapping
+ * an index is a mask.
+ */
+template<size_t Capacity>
+class EncoderRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "BasicEncoder capacity must be a power of two");
+public:
+    static constexpr size_t size() { return Capacity; }
+    uint8_t* data() { return buf.data(); }
+    const uint8_t* data() const { return buf.data(); }
+
+    // Wrap an index in [0, 2 * size()) into the ring
+    static constexpr size_t wrap(size_t index) { return index & (Capacity - 1); }
+
+private:
+    std::array<uint8_t, Capacity> buf{};
+};
+
+/**
+ * Heap-allocated ring buffer storage with its size given at runtime
+ */
+template<>
+class EncoderRing<DynamicCapacity> {
+public:
+    explicit EncoderRing(size_t size) : buf(size) {}
+
+    size_t size() const { return buf.size(); }
+    uint8_t* data() { return buf.data(); }
+    const uint8_t* data() const { return buf.data(); }
+
+    // Wrap an index in [0, 2 * size()) into the ring
+    size_t wrap(size_t index) const { return (index >= buf.size()) ? index - buf.size() : index; }
+
+private:
+    std::vector<uint8_t> buf;
+};
+
+} // namespace detail
+
+/**
+ * A stateful, non-blocking SLIP encoder with internal buffering, writing the
+ * encoded bytes to a [Sink] which is called like BulkOutputFn (see Encoder.hpp):
+ *
+ *    std::pair<WriteStatus, size_t> sink(const uint8_t* data, size_t length);
+ *
+ * With a fixed [Capacity] (a power of two), the queue is stored inside the encoder,
+ * so there is no heap allocation and the sink can be inlined into the encoder:
+ *
+ *    auto uart = [](const uint8_t* data, size_t length) { ... };
+ *    SLIPStream::BasicEncoder<decltype(uart), 256> encoder(uart);
+ *
+ * With DynamicCapacity, the queue size is passed to the constructor (see Encoder).
+ */
+template<typename Sink, size_t Capacity = DynamicCapacity>
+class BasicEncoder {
+public:
+    // Fixed capacity: The queue is part of the encoder
+    template<size_t C = Capacity, std::enable_if_t<C != DynamicCapacity, int> = 0>
+    explicit BasicEncoder(Sink sink, size_t maxSendChunk = 64)
+        : sink(std::move(sink)), txBuf(), txHead(0), txTail(0), txSize(0), maxSendChunk(maxSendChunk), endPending(false), inPacket(false),
+          appendCrc32(false), txCrc(), crcPending(0), atomicEnqueue(false) {}
+
+    // Dynamic capacity: A queue of txBufferSize bytes is allocated
+    template<size_t C = Capacity, std::enable_if_t<C == DynamicCapacity, int> = 0>
+    BasicEncoder(Sink sink, size_t txBufferSize, size_t maxSendChunk = 64)
+        : sink(std::move(sink)), txBuf(txBufferSize), txHead(0), txTail(0), txSize(0), maxSendChunk(maxSendChunk), endPending(false), inPacket(false),
+          appendCrc32(false), txCrc(), crcPending(0), atomicEnqueue(false) {}
+
+    // Attempt to flush up to maxSendChunk queued encoded bytes via the sink.
+    // Queues the (CRC and) END of the previous packet first if it did not fit before.
+    WriteStatus flush();
+
+    // Enhanced flush with error information
+    WriteResult flush_ex();
+
+    // Encode and queue a complete SLIP packet (payload escaped, END appended).
+    // Returns pair of (status, consumedBytes). On RetryLater with consumedBytes < size,
+    // call again with the data advanced by consumedBytes. With consumedBytes == size, only
+    // the trailer or queued bytes are left: call flush() until it returns Ok (calling
+    // pushPacket() again with zero bytes would start a new, empty packet).
+    std::pair<WriteStatus, size_t> pushPacket(const uint8_t* data, size_t size);
+
+    // Encode and queue a complete SLIP packet with chunk-based processing
+    // Processes data in chunks of specified size for better performance.
+    // Uses beginPacket()/append()/endPacket(): On RetryLater with payload bytes left, the
+    // packet stays open. Resume it with pushPacket_chunk() or append() and the data advanced
+    // by consumedBytes, or close it with endPacket(); pushPacket() fails until then.
+    // On RetryLater with all bytes consumed, only the trailer is left: call flush().
+    // In atomic enqueue mode, this is equivalent to pushPacket().
+    std::pair<WriteStatus, size_t> pushPacket_chunk(const uint8_t* data, size_t size, size_t chunk_size);
+
+    // Enhanced pushPacket with detailed error information
+    struct PushPacketResult {
+        WriteStatus status;
+        size_t consumed;
+        ErrorInfo error;
+
+        PushPacketResult(WriteStatus s, size_t c) : status(s), consumed(c), error(ErrorCode::Success) {}
+        PushPacketResult(ErrorCode code, size_t c, size_t pos = 0, const char* msg = "")
+            : status(WriteStatus::Error), consumed(c), error(code, pos, msg) {}
+
+        bool is_success() const { return status == WriteStatus::Ok; }
+        bool is_retry() const { return status == WriteStatus::RetryLater; }
+        bool is_error() const { return status == WriteStatus::Error; }
+    };
+    PushPacketResult pushPacket_ex(const uint8_t* data, size_t size);
+
+    // Enhanced chunk-based pushPacket with detailed error information
+    PushPacketResult pushPacket_chunk_ex(const uint8_t* data, size_t size, size_t chunk_size);
+
+    // Encode and queue the concatenation of the given segments (e.g. header, payload
+    // and trailer) as ONE SLIP packet, without copying them into a staging buffer.
+    // Returns pair of (status, consumedBytes), where consumedBytes counts across all
+    // segments in order. On RetryLater, resume like pushPacket(): with the segments advanced
+    // by consumedBytes, or with flush() if all of them have been consumed.
+    std::pair<WriteStatus, size_t> pushPacketv(const Segment* segments, size_t count);
+
+    // Enhanced pushPacketv with detailed error information
+    PushPacketResult pushPacketv_ex(const Segment* segments, size_t count);
+
+    // Streaming packet builder: Encode ONE SLIP packet whose payload arrives in pieces
+    // (e.g. from DMA) without assembling it first: beginPacket(), append() any number
+    // of times, endPacket(). pushPacket() is not allowed while the packet is open.
+
+    // Open a packet. Queues the END of the previous packet first if it is still pending
+    // (RetryLater: call again). Returns Error if a packet is already open.
+    WriteStatus beginPacket();
+    WriteResult beginPacket_ex();
+
+    // Escape and queue payload bytes of the open packet. Returns pair of (status, consumedBytes).
+    // On RetryLater, call again with the data advanced by consumedBytes.
+    std::pair<WriteStatus, size_t> append(const uint8_t* data, size_t size);
+    PushPacketResult append_ex(const uint8_t* data, size_t size);
+
+    // Close the open packet: Queue its (CRC and) END, then flush. Returns Ok once the
+    // trailer is queued. On RetryLater, it did not fit: call again (or flush()) until Ok.
+    // Returns Error if no packet is open.
+    WriteStatus endPacket();
+    WriteResult endPacket_ex();
+
+    bool packetOpen() const { return inPacket; }
+
+    void setMaxSendChunk(size_t n) { maxSendChunk = n; }
+
+    // CRC mode: Append the CRC32 of every packet (little-endian, escaped) before its END,
+    // like encode_packet_crc32(). The CRC is computed while the payload is escaped.
+    // Only change this between packets.
+    void setAppendCrc32(bool enable) { appendCrc32 = enable; }
+    bool appendsCrc32() const { return appendCrc32; }
+
+    // Atomic mode: pushPacket()/pushPacketv() (and their _ex variants) queue either the
+    // whole frame or nothing, so there are no half-queued frames: RetryLater means
+    // consumedBytes = 0, Ok means the complete frame (including END) has been queued.
+    // A frame larger than the queue can never be queued: WriteStatus::Error
+    // (ErrorCode::EncodeBufferTooSmall). The streaming packet builder is not affected.
+    void setAtomicEnqueue(bool enable) { atomicEnqueue = enable; }
+    bool enqueuesAtomically() const { return atomicEnqueue; }
+
+    // The queued encoded bytes as up to two contiguous segments of the ring buffer
+    // (the second one is empty unless the queue wraps around), e.g. for writev().
+    // The segments are valid until the next call of a non-const method.
+    struct ReadableSegments {
+        Segment first;
+        Segment second;
+
+        size_t total() const { return first.length + second.length; }
+    };
+    ReadableSegments readable_segments() const;
+
+    // Remove the first n queued bytes (e.g. after writing them from readable_segments())
+    // Returns the number of bytes removed, which is less than n if fewer are queued.
+    size_t consume(size_t n);
+
+    size_t queued() const { return txSize; }
+    size_t capacity() const { return txBuf.size(); }
+    size_t free() const { return txBuf.size() - txSize; }
+
+private:
+    // An empty std::function sink means queue only
+    bool hasSink() const {
+        if constexpr (detail::is_std_function<Sink>::value) {
+            return static_cast<bool>(sink);
+        } else {
+            return true;
+        }
+    }
+
+    // Internal helpers for queue management
+    bool queueByte(uint8_t b);
+
+    // Copy n bytes into the queue, which must have enough free space
+    void queueRun(const uint8_t* data, size_t n);
+
+    // Queue the escaped bytes of [in, inend) using at most [space] bytes of the queue.
+    // [in] is advanced past the bytes queued. Returns the number of bytes queued.
+    size_t queueEscaped(const uint8_t*& in, const uint8_t* inend, size_t space);
+
+    // Write up to maxSendChunk queued bytes, [sent] receives the number of bytes written
+    WriteStatus flushQueue(size_t& sent);
+
+    // Try to ensure at least 'n' bytes free in queue by flushing as needed
+    WriteStatus ensureFree(size_t n);
+
+    // Escape and queue payload bytes, flushing once per maxSendChunk window
+    // (or when the queue is full). [consumed] receives the number of payload bytes queued.
+    WriteStatus encodeSegment(const uint8_t* data, size_t size, size_t& consumed);
+
+    // Atomic mode: Queue the whole frame of the given segments or nothing. [tooLarge] is
+    // set if the frame can never fit into the queue (WriteStatus::Error).
+    WriteStatus enqueueAtomic(const Segment* segments, size_t count, size_t& consumed, bool& tooLarge);
+
+    // Queue the pending CRC trailer bytes (CRC mode) and the END of the current packet.
+    // On RetryLater, endPending stays set and the remaining bytes are queued on the next call.
+    WriteStatus finishPacket();
+
+    Sink sink;
+    detail::EncoderRing<Capacity> txBuf;
+    size_t txHead; // pop index
+    size_t txTail; // push index
+    size_t txSize; // number of bytes currently queued
+    size_t maxSendChunk;
+
+    // Packet state: whether we still need to append a trailing END for the current packet
+    bool endPending;
+    // Whether a packet is open between beginPacket() and endPacket()
+    bool inPacket;
+
+    // CRC mode state: running CRC32 of the current packet and the number of
+    // CRC trailer bytes which still need to be queued before END
+    bool appendCrc32;
+    Crc32Accumulator txCrc;
+    uint8_t crcPending;
+
+    // Atomic mode: Queue whole frames or nothing
+    bool atomicEnqueue;
+};
+
+template<typename Sink, size_t Capacity>
+bool BasicEncoder<Sink, Capacity>::queueByte(uint8_t b) {
+    if (txSize >= txBuf.size()) return false; // full
+    txBuf.data()[txTail] = b;
+    txTail = txBuf.wrap(txTail + 1);
+    txSize++;
+    return true;
+}
+
+template<typename Sink, size_t Capacity>
+void BasicEncoder<Sink, Capacity>::queueRun(const uint8_t* data, size_t n) {
+    if (n == 0) return;
+    // Copy up to the end of the ring, then the rest to its start
+    size_t first = std::min(n, txBuf.size() - txTail);
+    std::memcpy(txBuf.data() + txTail, data, first);
+    std::memcpy(txBuf.data(), data + first, n - first);
+    txTail = txBuf.wrap(txTail + n);
+    txSize += n;
+}
+
+template<typename Sink, size_t Capacity>
+size_t BasicEncoder<Sink, Capacity>::queueEscaped(const uint8_t*& in, const uint8_t* inend, size_t space) {
+    size_t queuedBytes = 0;
+    while (in < inend && queuedBytes < space) {
+        // Copy the run of bytes which don't need escaping in one go
+        const uint8_t* limit = in + std::min(static_cast<size_t>(inend - in), space - queuedBytes);
+        const uint8_t* special = detail::find_special(in, limit);
+        queueRun(in, static_cast<size_t>(special - in));
+        queuedBytes += static_cast<size_t>(special - in);
+        in = special;
+        if (in == limit) {
+            break; // End of input or no more space
+        }
+        // END or ESC: Never split an escape sequence
+        if (space - queuedBytes < 2) {
+            break;
+        }
+        queueByte(ESC);
+        queueByte(*in == END ? ESCEND : ESCESC);
+        queuedBytes += 2;
+        in++;
+    }
+    return queuedBytes;
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::flushQueue(size_t& sent) {
+    sent = 0;
+    if (!hasSink()) {
+        return WriteStatus::Ok; // Queue only
+    }
+    while (txSize > 0 && sent < maxSendChunk) {
+        // Contiguous run from txHead, up to the end of the ring
+        size_t run = std::min(std::min(txSize, txBuf.size() - txHead), maxSendChunk - sent);
+        std::pair<WriteStatus, size_t> result = sink(txBuf.data() + txHead, run);
+        size_t written = std::min(result.second, run);
+        txHead = txBuf.wrap(txHead + written);
+        txSize -= written;
+        sent += written;
+        if (result.first != WriteStatus::Ok) {
+            return result.first;
+        }
+        if (written < run) {
+            return WriteStatus::RetryLater; // Output is full
+        }
+    }
+    return WriteStatus::Ok;
+}
+
+template<typename Sink, size_t Capacity>
+auto BasicEncoder<Sink, Capacity>::readable_segments() const -> ReadableSegments {
+    size_t first = std::min(txSize, txBuf.size() - txHead);
+    return ReadableSegments{{txBuf.data() + txHead, first}, {txBuf.data(), txSize - first}};
+}
+
+template<typename Sink, size_t Capacity>
+size_t BasicEncoder<Sink, Capacity>::consume(size_t n) {
+    n = std::min(n, txSize);
+    if (n > 0) {
+        txHead = txBuf.wrap(txHead + n);
+        txSize -= n;
+    }
+    return n;
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::flush() {
+    if (endPending) {
+        WriteStatus st = finishPacket();
+        if (st != WriteStatus::Ok) return st;
+    }
+    size_t sent;
+    return flushQueue(sent);
+}
+
+template<typename Sink, size_t Capacity>
+WriteResult BasicEncoder<Sink, Capacity>::flush_ex() {
+    if (endPending) {
+        WriteStatus st = finishPacket();
+        if (st == WriteStatus::Error) {
+            return WriteResult(ErrorCode::EncodeInternalError, 0, "Output function returned error");
+        }
+        if (st != WriteStatus::Ok) return WriteResult(st);
+    }
+    size_t sent;
+    WriteStatus st = flushQueue(sent);
+    if (st == WriteStatus::Error) {
+        return WriteResult(ErrorCode::EncodeInternalError, sent, "Output function returned error");
+    }
+    return WriteResult(st);
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::ensureFree(size_t n) {
+    if (txBuf.size() - txSize >= n) return WriteStatus::Ok;
+    // Try to flush some bytes
+    size_t sent;
+    WriteStatus st = flushQueue(sent);
+    if (st != WriteStatus::Ok) return st;
+    return (txBuf.size() - txSize >= n) ? WriteStatus::Ok : WriteStatus::RetryLater;
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::encodeSegment(const uint8_t* data, size_t size, size_t& consumed) {
+    const uint8_t* in = data;
+    const uint8_t* inend = data + size;
+    WriteStatus st = WriteStatus::Ok;
+    while (in < inend) {
+        size_t space = txBuf.size() - txSize;
+        if (hasSink() && maxSendChunk > 0) {
+            // Queue at most one maxSendChunk window before flushing (at least one escape sequence)
+            size_t window = std::max<size_t>(maxSendChunk, 2);
+            space = std::min(space, window > txSize ? window - txSize : 0);
+        }
+        const uint8_t* runStart = in;
+        size_t queuedBytes = queueEscaped(in, inend, space);
+        if (appendCrc32) {
+            txCrc.update(runStart, static_cast<size_t>(in - runStart));
+        }
+        if (in == inend) {
+            break; // Flushed together with the end of the packet
+        }
+        // The window or the queue is full
+        size_t sent;
+        st = flushQueue(sent);
+        if (st != WriteStatus::Ok) {
+            break;
+        }
+        if (queuedBytes == 0 && sent == 0) {
+            st = WriteStatus::RetryLater; // No progress possible
+            break;
+        }
+    }
+    consumed = static_cast<size_t>(in - data);
+    return st;
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::finishPacket() {
+    while (crcPending > 0) {
+        // Little-endian: the LSB is sent first
+        uint8_t b = static_cast<uint8_t>(txCrc.value() >> (8 * (4 - crcPending)));
+        bool escape = (b == END || b == ESC);
+        WriteStatus st = ensureFree(escape ? 2 : 1);
+        if (st != WriteStatus::Ok) return st;
+        if (escape) {
+            queueByte(ESC);
+            queueByte(b == END ? ESCEND : ESCESC);
+        } else {
+            queueByte(b);
+        }
+        crcPending--;
+    }
+    WriteStatus st = ensureFree(1);
+    if (st != WriteStatus::Ok) return st;
+    queueByte(END);
+    endPending = false;
+    txCrc.reset(); // Start the CRC of the next packet
+    return WriteStatus::Ok;
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::enqueueAtomic(const Segment* segments, size_t count, size_t& consumed, bool& tooLarge) {
+    consumed = 0;
+    tooLarge = false;
+    // First, try to send any already queued bytes to make room
+    WriteStatus st = flush();
+    if (st == WriteStatus::Error) return st;
+    // Complete a packet left over from non-atomic mode
+    if (endPending) {
+        st = finishPacket();
+        if (st != WriteStatus::Ok) return st;
+    }
+    // Escaped payload and END (plus at least 4 CRC bytes)
+    size_t needed = encoded_lengthv(segments, count) + (appendCrc32 ? 4 : 0);
+    if (needed > txBuf.size()) {
+        tooLarge = true;
+        return WriteStatus::Error;
+    }
+    if (needed > txBuf.size() - txSize) return WriteStatus::RetryLater;
+    if (appendCrc32) {
+        // The exact length depends on how many CRC bytes need to be escaped
+        for (size_t i = 0; i < count; i++) {
+            txCrc.update(segments[i].data, segments[i].length);
+        }
+        for (int i = 0; i < 4; i++) {
+            uint8_t b = static_cast<uint8_t>(txCrc.value() >> (8 * i));
+            needed += (b == END || b == ESC) ? 1 : 0;
+        }
+        if (needed > txBuf.size() - txSize) {
+            txCrc.reset();
+            tooLarge = needed > txBuf.size();
+            return tooLarge ? WriteStatus::Error : WriteStatus::RetryLater;
+        }
+    }
+    // Everything fits: No flushing until the frame is complete
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* in = segments[i].data;
+        queueEscaped(in, in + segments[i].length, needed);
+        consumed += segments[i].length;
+    }
+    endPending = true;
+    crcPending = appendCrc32 ? 4 : 0;
+    finishPacket();
+    // The frame is queued even if the output blocks now
+    st = flush();
+    return (st == WriteStatus::Error) ? st : WriteStatus::Ok;
+}
+
+template<typename Sink, size_t Capacity>
+std::pair<WriteStatus, size_t> BasicEncoder<Sink, Capacity>::pushPacket(const uint8_t* data, size_t size) {
+    Segment segment{data, size};
+    return pushPacketv(&segment, 1);
+}
+
+template<typename Sink, size_t Capacity>
+std::pair<WriteStatus, size_t> BasicEncoder<Sink, Capacity>::pushPacketv(const Segment* segments, size_t count) {
+    size_t consumed = 0;
+    if (inPacket) return {WriteStatus::Error, consumed}; // Call endPacket() first
+    if (atomicEnqueue) {
+        bool tooLarge;
+        WriteStatus st = enqueueAtomic(segments, count, consumed, tooLarge);
+        return {st, consumed};
+    }
+    // First, try to send any already queued bytes for fairness
+    WriteStatus st = flush();
+    if (st == WriteStatus::Error) return {st, consumed};
+    if (st == WriteStatus::RetryLater) return {st, consumed};
+
+    // If we were in the middle of final END from previous call, attempt it
+    if (endPending) {
+        // Ensure space then queue (CRC and) END
+        st = finishPacket();
+        if (st != WriteStatus::Ok) return {st, consumed};
+        // Try to send a bit immediately to reduce latency
+        st = flush();
+        if (st != WriteStatus::Ok) return {st, consumed};
+    }
+
+    // Encode payload bytes of all segments
+    for (size_t i = 0; i < count; i++) {
+        size_t c = 0;
+        st = encodeSegment(segments[i].data, segments[i].length, c);
+        consumed += c;
+        if (st != WriteStatus::Ok) return {st, consumed};
+    }
+
+    // Append (CRC and) END terminator for the packet
+    endPending = true; // Remember to append END on next call if it does not fit now
+    crcPending = appendCrc32 ? 4 : 0;
+    st = finishPacket();
+    if (st != WriteStatus::Ok) return {st, consumed};
+
+    // Final flush attempt
+    st = flush();
+    if (st != WriteStatus::Ok) return {st, consumed};
+    return {WriteStatus::Ok, consumed};
+}
+
+template<typename Sink, size_t Capacity>
+auto BasicEncoder<Sink, Capacity>::pushPacket_ex(const uint8_t* data, size_t size) -> PushPacketResult {
+    Segment segment{data, size};
+    return pushPacketv_ex(&segment, 1);
+}
+
+template<typename Sink, size_t Capacity>
+auto BasicEncoder<Sink, Capacity>::pushPacketv_ex(const Segment* segments, size_t count) -> PushPacketResult {
+    size_t consumed = 0;
+    if (inPacket) {
+        return PushPacketResult(ErrorCode::EncodeInvalidPacketState, consumed, consumed, "A packet is open, call endPacket() first");
+    }
+    if (atomicEnqueue) {
+        bool tooLarge;
+        WriteStatus st = enqueueAtomic(segments, count, consumed, tooLarge);
+        if (tooLarge) {
+            return PushPacketResult(ErrorCode::EncodeBufferTooSmall, consumed, consumed, "Packet does not fit into the queue");
+        }
+        if (st == WriteStatus::Error) {
+            return PushPacketResult(ErrorCode::EncodeInternalError, consumed, consumed, "Output function returned error");
+        }
+        return PushPacketResult(st, consumed);
+    }
+    // First, try to send any already queued bytes for fairness
+    WriteResult wr = flush_ex();
+    if (wr.is_error()) return PushPacketResult(wr.error.code, consumed, consumed, wr.error.message);
+    if (wr.is_retry()) return PushPacketResult(WriteStatus::RetryLater, consumed);
+
+    // If we were in the middle of final END from previous call, attempt it
+    if (endPending) {
+        // Ensure space then queue (CRC and) END
+        WriteStatus st = finishPacket();
+        if (st != WriteStatus::Ok) {
+            if (st == WriteStatus::RetryLater) {
+                return PushPacketResult(WriteStatus::RetryLater, consumed);
+            }
+            return PushPacketResult(ErrorCode::EncodeInternalError, consumed, consumed, "Failed to ensure free space for pending END");
+        }
+        // Try to send a bit immediately to reduce latency
+        wr = flush_ex();
+        if (wr.is_error()) return PushPacketResult(wr.error.code, consumed, consumed, wr.error.message);
+        if (wr.is_retry()) return PushPacketResult(WriteStatus::RetryLater, consumed);
+    }
+
+    // Encode payload bytes of all segments
+    for (size_t i = 0; i < count; i++) {
+        size_t c = 0;
+        WriteStatus st = encodeSegment(segments[i].data, segments[i].length, c);
+        consumed += c;
+        if (st == WriteStatus::RetryLater) {
+            return PushPacketResult(WriteStatus::RetryLater, consumed);
+        }
+        if (st == WriteStatus::Error) {
+            return PushPacketResult(ErrorCode::EncodeInternalError, consumed, consumed, "Output function returned error");
+        }
+    }
+
+    // Append (CRC and) END terminator for the packet
+    endPending = true; // Remember to append END on next call if it does not fit now
+    crcPending = appendCrc32 ? 4 : 0;
+    WriteStatus st = finishPacket();
+    if (st != WriteStatus::Ok) {
+        return PushPacketResult(WriteStatus::RetryLater, consumed);
+    }
+
+    // Final flush attempt
+    wr = flush_ex();
+    if (wr.is_error()) return PushPacketResult(wr.error.code, consumed, consumed, wr.error.message);
+    if (wr.is_retry()) return PushPacketResult(WriteStatus::RetryLater, consumed);
+    return PushPacketResult(WriteStatus::Ok, consumed);
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::beginPacket() {
+    if (inPacket) return WriteStatus::Error;
+    // Complete the previous packet first
+    if (endPending) {
+        WriteStatus st = finishPacket();
+        if (st != WriteStatus::Ok) return st;
+    }
+    inPacket = true;
+    return WriteStatus::Ok;
+}
+
+template<typename Sink, size_t Capacity>
+WriteResult BasicEncoder<Sink, Capacity>::beginPacket_ex() {
+    if (inPacket) {
+        return WriteResult(ErrorCode::EncodeInvalidPacketState, 0, "A packet is already open");
+    }
+    WriteStatus st = beginPacket();
+    if (st == WriteStatus::Error) {
+        return WriteResult(ErrorCode::EncodeInternalError, 0, "Output function returned error");
+    }
+    return WriteResult(st);
+}
+
+template<typename Sink, size_t Capacity>
+std::pair<WriteStatus, size_t> BasicEncoder<Sink, Capacity>::append(const uint8_t* data, size_t size) {
+    if (!inPacket) return {WriteStatus::Error, 0};
+    size_t consumed = 0;
+    WriteStatus st = encodeSegment(data, size, consumed);
+    return {st, consumed};
+}
+
+template<typename Sink, size_t Capacity>
+auto BasicEncoder<Sink, Capacity>::append_ex(const uint8_t* data, size_t size) -> PushPacketResult {
+    if (!inPacket) {
+        return PushPacketResult(ErrorCode::EncodeInvalidPacketState, 0, 0, "No packet open, call beginPacket() first");
+    }
+    auto [st, consumed] = append(data, size);
+    if (st == WriteStatus::Error) {
+        return PushPacketResult(ErrorCode::EncodeInternalError, consumed, consumed, "Output function returned error");
+    }
+    return PushPacketResult(st, consumed);
+}
+
+template<typename Sink, size_t Capacity>
+WriteStatus BasicEncoder<Sink, Capacity>::endPacket() {
+    if (inPacket) {
+        inPacket = false;
+        endPending = true;
+        crcPending = appendCrc32 ? 4 : 0;
+    } else if (!endPending) {
+        return WriteStatus::Error; // No packet open
+    }
+    // On RetryLater, endPending stays set: Repeated calls resume the trailer
+    WriteStatus st = finishPacket();
+    if (st != WriteStatus::Ok) return st;
+    // The packet is complete even if the output blocks now
+    st = flush();
+    return (st == WriteStatus::Error) ? st : WriteStatus::Ok;
+}
+
+template<typename Sink, size_t Capacity>
+WriteResult BasicEncoder<Sink, Capacity>::endPacket_ex() {
+    if (!inPacket && !endPending) {
+        return WriteResult(ErrorCode::EncodeInvalidPacketState, 0, "No packet open, call beginPacket() first");
+    }
+    WriteStatus st = endPacket();
+    if (st == WriteStatus::Error) {
+        return WriteResult(ErrorCode::EncodeInternalError, 0, "Output function returned error");
+    }
+    return WriteResult(st);
+}
+
+template<typename Sink, size_t Capacity>
+std::pair<WriteStatus, size_t> BasicEncoder<Sink, Capacity>::pushPacket_chunk(const uint8_t* data, size_t size, size_t chunk_size) {
+    if (atomicEnqueue && !inPacket) {
+        // The whole frame is queued at once, chunking makes no difference
+        return pushPacket(data, size);
+    }
+    size_t consumed = 0;
+    if (!inPacket) {
+        WriteStatus st = beginPacket();
+        if (st != WriteStatus::Ok) return {st, consumed};
+    }
+    while (consumed < size) {
+        size_t to_process = std::min(chunk_size, size - consumed);
+        auto [status, c] = append(data + consumed, to_process);
+        consumed += c;
+        if (status != WriteStatus::Ok) {
+            return {status, consumed};
+        }
+    }
+    return {endPacket(), consumed};
+}
+
+template<typename Sink, size_t Capacity>
+auto BasicEncoder<Sink, Capacity>::pushPacket_chunk_ex(const uint8_t* data, size_t size, size_t chunk_size) -> PushPacketResult {
+    if (atomicEnqueue && !inPacket) {
+        return pushPacket_ex(data, size);
+    }
+    auto [st, consumed] = pushPacket_chunk(data, size, chunk_size);
+    if (st == WriteStatus::Error) {
+        return PushPacketResult(ErrorCode::EncodeInternalError, consumed, consumed, "Output function returned error");
+    }
+    return PushPacketResult(st, consumed);
+}
+
+} // namespace SLIPStream
@@ -43,6 +43,8 @@ Result<size_t> encoded_length_ex(const uint8_t* in, size_t inlen);
  * the output buffer will be left in an undefined space.
  * Take special care that the input data does not change between the calls to
  * encoded_length() and encode_packet()
+ * NOTE: Runs of bytes are copied using vector stores, so bytes in [out] after the
+ *    returned length (but within [outlen]) may be overwritten as well.
  * @return The number of bytes in [out], or ENCODE_ERROR
  */
 size_t encode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
@@ -53,6 +55,91 @@ size_t encode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outle
  */
 Result<size_t> encode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
 
+/**
+ * Scatter-gather version of encoded_length(): Determine the length of the packet
+ * consisting of the concatenation of the given segments.
+ * @return The number of bytes a SLIP encoded version of the segments would consume
+ */
+size_t encoded_lengthv(const Segment* segments, size_t count);
+
+/**
+ * Scatter-gather version of encode_packet(): Encode the concatenation of the given
+ * segments (e.g. header, payload and trailer) as ONE SLIP packet, without copying
+ * them into a contiguous staging buffer first.
+ * The output buffer MUST have a length of at least encoded_lengthv(segments, count).
+ * NOTE: Runs of bytes are copied using vector stores, so bytes in [out] after the
+ *    returned length (but within [outlen]) may be overwritten as well.
+ * @return The number of bytes in [out], or ENCODE_ERROR
+ */
+size_t encode_packetv(const Segment* segments, size_t count, uint8_t* out, size_t outlen);
+
+/**
+ * Enhanced version of encode_packetv with detailed error reporting.
+ * Error positions refer to the concatenation of all segments.
+ * @return Result<size_t> containing the number of bytes written or error information
+ */
+Result<size_t> encode_packetv_ex(const Segment* segments, size_t count, uint8_t* out, size_t outlen);
+
+/**
+ * Upper bound for the encoded length of any [inlen] bytes of data:
+ * Every byte is escaped (2 bytes each), plus the trailing END byte.
+ * Can be used to size buffers at compile time, e.g.
+ *    uint8_t out[max_encoded_length(sizeof(payload))];
+ * @return 2 * inlen + 1
+ */
+constexpr size_t max_encoded_length(size_t inlen) {
+    return 2 * inlen + 1;
+}
+
+/**
+ * Encode given input data using SLIP in a single pass, without computing
+ * encoded_length() first.
+ * The output buffer MUST have a length of at least max_encoded_length(inlen),
+ * which is checked up front. Since the worst case always fits, no further bounds
+ * checks are required while encoding and every input byte is read only once.
+ * NOTE: Runs of bytes are copied using vector stores, so bytes in [out] after the
+ *    returned length (but within [outlen]) may be overwritten as well.
+ * @return The number of bytes in [out] (the actual encoded length), or ENCODE_ERROR
+ *    if [outlen] is smaller than max_encoded_length(inlen)
+ */
+size_t encode_packet_max(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
+/**
+ * Enhanced version of encode_packet_max with detailed error reporting
+ * @return Result<size_t> containing the number of bytes written or error information
+ */
+Result<size_t> encode_packet_max_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
+/**
+ * Upper bound for the encoded length of [inlen] bytes of data followed by
+ * the 4 byte CRC32 trailer, see encode_packet_crc32()
+ * @return 2 * (inlen + 4) + 1
+ */
+constexpr size_t max_encoded_length_crc32(size_t inlen) {
+    return max_encoded_length(inlen + 4);
+}
+
+/**
+ * Encode given input data using SLIP and append its CRC32 (see CRC32.hpp),
+ * i.e. the packet [in] + CRC32 (little-endian) + END, as recommended in FramingConvention.md.
+ * This is equivalent to append_crc32() followed by encode_packet(), but the CRC is
+ * computed while escaping, so [in] is read only once and does not need 4 bytes of
+ * spare capacity. The CRC bytes are escaped like any other data byte.
+ * The output buffer MUST have a length of at least max_encoded_length_crc32(inlen),
+ * or the exact encoded length of the payload plus CRC.
+ * NOTE: Runs of bytes are copied using vector stores, so bytes in [out] after the
+ *    returned length (but within [outlen]) may be overwritten as well.
+ * @return The number of bytes in [out], or ENCODE_ERROR
+ */
+size_t encode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
+/**
+ * Enhanced version of encode_packet_crc32 with detailed error reporting.
+ * Error positions >= inlen refer to the CRC trailer.
+ * @return Result<size_t> containing the number of bytes written or error information
+ */
+Result<size_t> encode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
 /**
  * Determine the decoded packet length when receiving a SLIP-encoded buffer [in].
  * Decoding will stop at the first END byte (0xC0). Escapes are resolved
@@ -86,6 +173,9 @@ Result<size_t> decoded_length_ex(const uint8_t* in, size_t inlen);
  *  - Returns DECODE_ERROR if no END byte is present in [in]
  *  - Returns DECODE_ERROR for malformed escape sequences
  *
+ * NOTE: Runs of bytes are copied using vector stores, so bytes in [out] after the
+ * returned length (but within [outlen]) may be overwritten as well.
+ *
  * @return The number of bytes written to [out], or DECODE_ERROR on error.
  */
 size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
@@ -96,4 +186,138 @@ size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outle
  */
 Result<size_t> decode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
 
+/**
+ * Cursor-style version of decode_packet() for buffers containing multiple frames.
+ * Decodes the first frame in [in] like decode_packet() and additionally reports
+ * the number of input bytes consumed, including the terminating END byte.
+ * The next frame starts at in + *consumed, so a whole receive buffer can be
+ * decoded in a single pass:
+ *
+ *    while (inlen > 0) {
+ *        size_t consumed;
+ *        size_t len = decode_packet(in, inlen, out, outlen, &consumed);
+ *        if (len == DECODE_ERROR) break; // Incomplete or malformed frame
+ *        handle_frame(out, len);
+ *        in += consumed; inlen -= consumed;
+ *    }
+ *
+ * @param consumed Set to the number of input bytes consumed on success,
+ *    not modified on error. May be nullptr.
+ * @return The number of bytes written to [out], or DECODE_ERROR on error.
+ */
+size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed);
+
+/**
+ * Enhanced version of the cursor-style decode_packet() with detailed error reporting
+ * @param consumed Set to the number of input bytes consumed (including END) on success,
+ *    not modified on error. May be nullptr.
+ * @return Result<size_t> containing the number of bytes written or error information with position
+ */
+Result<size_t> decode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed);
+
+/**
+ * Decode the first SLIP frame in [in] and verify its CRC32 trailer in a single pass,
+ * i.e. the counterpart of encode_packet_crc32(). This is equivalent to decode_packet()
+ * followed by verify_crc32(), but the CRC is updated while bytes are unescaped, so the
+ * frame is read only once.
+ *
+ * [out] receives the decoded frame INCLUDING the 4 byte CRC trailer, so it must have
+ * room for decoded_length(in, inlen) bytes, i.e. the payload plus 4 bytes.
+ *
+ * Error conditions:
+ *  - Returns DECODE_ERROR for malformed frames (see decode_packet())
+ *  - Returns DECODE_ERROR if the CRC32 does not match, or the frame is shorter than 4 bytes
+ *
+ * @return The payload length (without CRC), or DECODE_ERROR on error.
+ */
+size_t decode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
+/**
+ * Cursor-style version of decode_packet_crc32(), see decode_packet()
+ * @param consumed Set to the number of input bytes consumed (including END) on success
+ *    and on CRC mismatch (the frame is complete, skip it), not modified if the frame
+ *    is malformed. May be nullptr.
+ */
+size_t decode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed);
+
+/**
+ * Enhanced version of decode_packet_crc32 with detailed error reporting.
+ * Distinguishes the three outcomes of a frame:
+ *  - Valid: success, the value is the payload length
+ *  - CRC error: ErrorCode::DecodeCrcMismatch, the position is the payload length
+ *  - Malformed: the error codes of decode_packet_ex()
+ * @return Result<size_t> containing the payload length or error information with position
+ */
+Result<size_t> decode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen);
+
+/**
+ * Enhanced version of the cursor-style decode_packet_crc32() with detailed error reporting
+ * @param consumed See the cursor-style decode_packet_crc32(). May be nullptr.
+ */
+Result<size_t> decode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed);
+
+/**
+ * Decode the first SLIP frame in [buf] in place, i.e. the decoded data
+ * overwrites the encoded data, starting at buf[0].
+ * This is always possible since decoding never grows the data, so no separate
+ * output buffer is required. Frames without escape sequences are not moved at all.
+ *
+ * Error conditions:
+ *  - Returns DECODE_ERROR if no END byte is present in [buf]
+ *  - Returns DECODE_ERROR for malformed escape sequences
+ * On error, the part of the frame before the error has already been decoded in
+ * place, i.e. [buf] is modified.
+ *
+ * @return The number of decoded bytes at the start of [buf], or DECODE_ERROR on error.
+ */
+size_t decode_packet_inplace(uint8_t* buf, size_t len);
+
+/**
+ * Cursor-style version of decode_packet_inplace(), see decode_packet()
+ * @param consumed Set to the number of bytes of the encoded frame (including END)
+ *    on success, not modified on error. May be nullptr.
+ */
+size_t decode_packet_inplace(uint8_t* buf, size_t len, size_t* consumed);
+
+/**
+ * Enhanced version of decode_packet_inplace with detailed error reporting
+ * @return Result<size_t> containing the number of decoded bytes or error information with position
+ */
+Result<size_t> decode_packet_inplace_ex(uint8_t* buf, size_t len);
+
+/**
+ * Enhanced version of the cursor-style decode_packet_inplace() with detailed error reporting
+ * @param consumed Set to the number of bytes of the encoded frame (including END)
+ *    on success, not modified on error. May be nullptr.
+ */
+Result<size_t> decode_packet_inplace_ex(uint8_t* buf, size_t len, size_t* consumed);
+
+/**
+ * Location of one decoded frame within the output arena of decode_all_packets()
+ */
+struct FrameRef {
+    size_t offset; // Index of the first byte of the frame in the output arena
+    size_t length; // Number of decoded bytes
+};
+
+/**
+ * Decode every complete frame in [in] into one contiguous output arena [out].
+ * For every frame, its location in [out] is stored in [frames] (in order),
+ * frames are stored back-to-back in [out] without gaps.
+ *
+ * - Empty frames (e.g. a leading END used to flush line noise) are skipped.
+ * - Malformed frames (invalid escape sequence) are dropped up to and including
+ *    their terminating END.
+ * - Decoding stops at an incomplete frame at the end of [in] (no END yet),
+ *    after [max_frames] frames, or when the next frame does not fit into the
+ *    remaining space in [out]. Since decoding never grows data, an arena of
+ *    [inlen] bytes is always large enough.
+ *
+ * @param consumed Set to the number of input bytes processed, i.e. the offset of the
+ *    first frame which has not been decoded (keep these bytes for the next call). May be nullptr.
+ * @return The number of frames stored in [frames]
+ */
+size_t decode_all_packets(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen,
+                          FrameRef* frames, size_t max_frames, size_t* consumed);
+
 } // namespace SLIPStream
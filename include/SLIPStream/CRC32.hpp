@@ -11,6 +11,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include "SLIPStream/Crc.hpp"
 
 namespace SLIPStream {
 
@@ -20,10 +21,13 @@ namespace SLIPStream {
  * Specification:
  * - Polynomial: 0x04C11DB7 (Ethernet polynomial)
  * - Initial value: 0xFFFFFFFF
- * - Final XOR: 0xFFFFFFFF
+ * - Final XOR: None
  * - Bit order: MSB-first (big-endian per polynomial definition)
  * - Input reflection: None
  * - Output reflection: None
+ *
+ * The same CRC is available as the compile-time engine SLIPStream::Crc32
+ * (see Crc.hpp), which also documents the exact table polynomial.
  * 
  * @param data Pointer to data buffer
  * @param length Length of data in bytes
@@ -43,6 +47,102 @@ uint32_t calculate_crc32(const uint8_t* data, size_t length);
  */
 uint32_t calculate_crc32_with_initial(const uint8_t* data, size_t length, uint32_t initial_crc);
 
+/**
+ * Running CRC32 for data which arrives in pieces, e.g. bytes flowing through
+ * Encoder::pushPacket() or Decoder::consume(). value() is the CRC32 of all data
+ * passed to update() since construction or the last reset(), identical to
+ * calculate_crc32() of the concatenated data.
+ */
+class Crc32Accumulator {
+public:
+    explicit Crc32Accumulator(uint32_t initial_crc = 0xFFFFFFFF) : crc(initial_crc), initialCrc(initial_crc) {}
+
+    /**
+     * Add a block of data (uses the fastest CRC32 kernel)
+     */
+    void update(const uint8_t* data, size_t length) {
+        crc = calculate_crc32_with_initial(data, length, crc);
+    }
+
+    /**
+     * Add a single byte (inline table lookup, see SLIPSTREAM_CRC32_BITWISE/NIBBLE)
+     */
+    void update(uint8_t byte) {
+#if defined(SLIPSTREAM_CRC32_BITWISE) || defined(SLIPSTREAM_CRC32_NIBBLE)
+        update(&byte, 1); // Avoid the 1 KiB table in memory-constrained builds
+#else
+        crc = Crc32::update(crc, &byte, 1);
+#endif
+    }
+
+    /**
+     * @return CRC32 of the data added so far
+     */
+    uint32_t value() const { return crc; }
+
+    /**
+     * Start over with the initial value
+     */
+    void reset() { crc = initialCrc; }
+
+private:
+    uint32_t crc;
+    uint32_t initialCrc;
+};
+
+/**
+ * Combine the CRC32s of two consecutive blocks of data
+ * 
+ * Given crc_a = calculate_crc32(A) and crc_b = calculate_crc32(B), computes
+ * calculate_crc32(A followed by B) without accessing the data.
+ * This takes O(log(length_b)) time.
+ * 
+ * @param crc_a CRC32 of the first block
+ * @param crc_b CRC32 of the second block
+ * @param length_b Length of the second block in bytes
+ * @return CRC32 of the concatenation of both blocks
+ */
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t length_b);
+
+/**
+ * Calculate CRC32 checksum using multiple threads
+ * 
+ * Splits the data into one chunk per thread, calculates the CRC32s of the chunks
+ * concurrently and combines them using crc32_combine(). The result is identical
+ * to calculate_crc32(). Small inputs (less than 1 MiB per thread) use fewer
+ * threads, down to calculating the CRC32 in the calling thread only.
+ * 
+ * Threads are started for each call instead of being kept in a pool: Each thread
+ * processes at least 1 MiB, so starting it (tens of microseconds) is negligible
+ * for the large inputs this is meant for, and no threads linger between calls.
+ * If a thread cannot be started, the calling thread processes its part (if the
+ * library is built with exceptions enabled; otherwise, std::thread aborts).
+ * If the library is built with SLIPSTREAM_NO_THREADS defined (e.g. for platforms
+ * without std::thread), this is equivalent to calculate_crc32().
+ * 
+ * @param data Pointer to data buffer
+ * @param length Length of data in bytes
+ * @param max_threads Maximum number of threads including the calling thread
+ *    (0: std::thread::hardware_concurrency())
+ * @return CRC32 checksum
+ */
+uint32_t calculate_crc32_parallel(const uint8_t* data, size_t length, unsigned max_threads = 0);
+
+/**
+ * Calculate the CRC32 checksums of many buffers
+ * 
+ * out[i] = calculate_crc32(bufs[i], lens[i]) for every i < n. Several buffers are
+ * processed in lockstep, so the independent CRC calculations overlap instead of
+ * waiting for each other. This is faster than calling calculate_crc32() in a loop
+ * for many short buffers, e.g. a batch of received frames.
+ * 
+ * @param bufs Pointers to the data buffers
+ * @param lens Lengths of the data buffers in bytes
+ * @param out Receives the CRC32 checksums (n entries)
+ * @param n Number of buffers
+ */
+void calculate_crc32_batch(const uint8_t* const* bufs, const size_t* lens, uint32_t* out, size_t n);
+
 /**
  * Append CRC32 checksum to data in little-endian format
  * 
@@ -79,4 +179,65 @@ size_t extract_crc32(const uint8_t* data, size_t length, uint32_t* crc_out);
  */
 bool verify_crc32(const uint8_t* data, size_t length);
 
+/**
+ * Calculate CRC-32C (Castagnoli) checksum
+ * 
+ * An alternative to CRC32 for links between hosts with hardware CRC-32C support:
+ * On x86-64 CPUs with SSE4.2, it is calculated using the crc32 instruction
+ * on three interleaved streams, with a table-driven
+ * slicing-by-8 fallback on other CPUs. See Dispatch.hpp.
+ * 
+ * Specification (standard CRC-32C, see also SLIPStream::Crc32C in Crc.hpp):
+ * - Polynomial: 0x1EDC6F41 (Castagnoli polynomial)
+ * - Initial value: 0xFFFFFFFF
+ * - Final XOR: 0xFFFFFFFF
+ * - Input reflection: Yes
+ * - Output reflection: Yes
+ * 
+ * @param data Pointer to data buffer
+ * @param length Length of data in bytes
+ * @return CRC-32C checksum
+ */
+uint32_t calculate_crc32c(const uint8_t* data, size_t length);
+
+/**
+ * Calculate CRC-32C checksum with initial value
+ * 
+ * Allows for incremental CRC calculation by passing previous result as initial value.
+ * 
+ * @param data Pointer to data buffer
+ * @param length Length of data in bytes
+ * @param initial_crc Previous CRC-32C result (use 0 for standard calculation)
+ * @return CRC-32C checksum
+ */
+uint32_t calculate_crc32c_with_initial(const uint8_t* data, size_t length, uint32_t initial_crc);
+
+/**
+ * Append CRC-32C checksum to data in little-endian format
+ * 
+ * @param data Pointer to data buffer (must have at least length+4 bytes available)
+ * @param length Length of data in bytes (will be increased by 4)
+ * @return New total length (length + 4)
+ */
+size_t append_crc32c(uint8_t* data, size_t length);
+
+/**
+ * Extract CRC-32C checksum from data in little-endian format
+ * 
+ * @param data Pointer to data buffer
+ * @param length Length of data in bytes (must be at least 4)
+ * @param crc_out Pointer to store extracted CRC-32C value
+ * @return Length of data without CRC (length - 4), or 0 on error
+ */
+size_t extract_crc32c(const uint8_t* data, size_t length, uint32_t* crc_out);
+
+/**
+ * Verify CRC-32C checksum in data
+ * 
+ * @param data Pointer to data buffer
+ * @param length Length of data in bytes (must be at least 4)
+ * @return true if CRC-32C matches, false otherwise
+ */
+bool verify_crc32c(const uint8_t* data, size_t length);
+
 } // namespace SLIPStream
@@ -0,0 +1,173 @@
+/**
+ * @file Crc.hpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * Generic CRC engine with lookup tables generated at compile time
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace SLIPStream {
+
+namespace detail {
+
+/**
+ * Smallest unsigned integer type holding [Width] bits
+ */
+template<unsigned Width>
+using CrcValue = std::conditional_t<(Width <= 8), uint8_t,
+                 std::conditional_t<(Width <= 16), uint16_t,
+                 std::conditional_t<(Width <= 32), uint32_t, uint64_t>>>;
+
+/**
+ * @return All ones in the lowest [width] bits
+ */
+constexpr uint64_t crc_mask(unsigned width) {
+    return (width >= 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << width) - 1);
+}
+
+/**
+ * Reverse the order of the lowest [width] bits of [value]
+ */
+constexpr uint64_t crc_reflect(uint64_t value, unsigned width) {
+    uint64_t result = 0;
+    for (unsigned i = 0; i < width; i++) {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+/**
+ * Generate the lookup table for byte-wise CRC calculation:
+ * MSB-first (RefIn = false) or LSB-first using the reflected polynomial (RefIn = true)
+ */
+template<typename T, unsigned Width, uint64_t Poly, bool RefIn>
+constexpr std::array<T, 256> make_crc_table() {
+    std::array<T, 256> table{};
+    const uint64_t mask = crc_mask(Width);
+    const uint64_t top = static_cast<uint64_t>(1) << (Width - 1);
+    const uint64_t reflected_poly = crc_reflect(Poly, Width);
+    for (uint64_t i = 0; i < 256; i++) {
+        uint64_t crc = 0;
+        if (RefIn) {
+            crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? ((crc >> 1) ^ reflected_poly) : (crc >> 1);
+            }
+        } else {
+            crc = i << (Width - 8);
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & top) ? ((crc << 1) ^ Poly) : (crc << 1);
+            }
+        }
+        table[i] = static_cast<T>(crc & mask);
+    }
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * CRC engine for the CRC described by the usual parameters ("Rocksoft model"):
+ *
+ * @tparam Width Number of bits (8 to 64)
+ * @tparam Poly Generator polynomial without the x^Width term, MSB-first notation
+ * @tparam Init Initial register value (not reflected)
+ * @tparam RefIn Process the bits of every input byte LSB-first
+ * @tparam RefOut Reflect the final register value
+ * @tparam XorOut Value XORed to the final register value
+ *
+ * The lookup table is generated at compile time and all functions are constexpr,
+ * so there is no runtime initialization and the byte-wise loop can be inlined.
+ * Incremental calculation:
+ *
+ *    auto crc = Crc16Ccitt::initial();
+ *    crc = Crc16Ccitt::update(crc, part1, len1);
+ *    crc = Crc16Ccitt::update(crc, part2, len2);
+ *    uint16_t result = Crc16Ccitt::finalize(crc);
+ */
+template<unsigned Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut>
+struct Crc {
+    static_assert(Width >= 8 && Width <= 64, "CRC width must be between 8 and 64 bits");
+
+    using value_type = detail::CrcValue<Width>;
+
+    static constexpr unsigned width = Width;
+    static constexpr value_type polynomial = static_cast<value_type>(Poly & detail::crc_mask(Width));
+    static constexpr value_type mask = static_cast<value_type>(detail::crc_mask(Width));
+
+    /**
+     * Lookup table for the byte-wise update()
+     */
+    static constexpr std::array<value_type, 256> table = detail::make_crc_table<value_type, Width, Poly, RefIn>();
+
+    /**
+     * @return The register value before any data has been processed
+     */
+    static constexpr value_type initial() {
+        return static_cast<value_type>(RefIn ? detail::crc_reflect(Init, Width) : (Init & detail::crc_mask(Width)));
+    }
+
+    /**
+     * Update the register value [crc] with the given data
+     * @return The new register value (call finalize() to obtain the CRC)
+     */
+    static constexpr value_type update(value_type crc, const uint8_t* data, size_t length) {
+        uint64_t reg = crc;
+        for (size_t i = 0; i < length; i++) {
+            if (RefIn) {
+                reg = (reg >> 8) ^ table[(reg ^ data[i]) & 0xFF];
+            } else {
+                reg = ((reg << 8) ^ table[((reg >> (Width - 8)) ^ data[i]) & 0xFF]) & detail::crc_mask(Width);
+            }
+        }
+        return static_cast<value_type>(reg);
+    }
+
+    /**
+     * @return The CRC for the register value [crc] (output reflection and XOR applied)
+     */
+    static constexpr value_type finalize(value_type crc) {
+        uint64_t reg = (RefIn != RefOut) ? detail::crc_reflect(crc, Width) : crc;
+        return static_cast<value_type>((reg ^ XorOut) & detail::crc_mask(Width));
+    }
+
+    /**
+     * @return The CRC of the given data
+     */
+    static constexpr value_type calculate(const uint8_t* data, size_t length) {
+        return finalize(update(initial(), data, length));
+    }
+};
+
+/**
+ * The CRC32 of CRC32.hpp (calculate_crc32() etc.), which uses the CRC32 dispatch
+ * kernels (slicing-by-16, PCLMULQDQ) for longer data.
+ * NOTE: Its lookup table implements the Ethernet polynomial 0x04C11DB7 shifted
+ * left by one bit, which is kept for compatibility with existing data.
+ */
+using Crc32 = Crc<32, 0x09823B6E, 0xFFFFFFFF, false, false, 0>;
+
+/**
+ * CRC-32C (Castagnoli), as used by iSCSI, SCTP and ext4
+ */
+using Crc32C = Crc<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+
+/**
+ * CRC-16/CCITT-FALSE (also known as CRC-16/IBM-3740)
+ */
+using Crc16Ccitt = Crc<16, 0x1021, 0xFFFF, false, false, 0>;
+
+/**
+ * CRC-16/KERMIT (the reflected CCITT CRC, also known as CRC-16/CCITT-TRUE)
+ */
+using Crc16Kermit = Crc<16, 0x1021, 0x0000, true, true, 0>;
+
+} // namespace SLIPStream
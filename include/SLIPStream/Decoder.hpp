@@ -12,13 +12,16 @@
 #include <functional>
 #include <vector>
 #include "SLIPStream/SLIP.hpp"
+#include "SLIPStream/CRC32.hpp"
 #include "SLIPStream/Error.hpp"
 
 namespace SLIPStream {
 
 enum class LogType: uint8_t {
     Unknown = 0,
-    RXBufferOverflow = 1
+    RXBufferOverflow = 1,
+    CrcMismatch = 2,
+    InvalidEscapeSequence = 3
 };
 
 /**
@@ -65,6 +68,22 @@ public:
     // Enhanced chunk consume with error reporting
     ConsumeResult consume_chunk_ex(const uint8_t* data, size_t size, size_t chunk_size);
 
+    // In-place mode: Consume a received buffer, unescaping complete frames within [data]
+    // itself (see decode_packet_inplace()). The message callback receives pointers into
+    // [data], so frames are neither copied nor limited by the RX buffer size.
+    // A frame started in a previous call is completed using the RX buffer, an incomplete
+    // frame at the end of [data] is copied to the RX buffer. Invalid escape sequences are
+    // handled and reported like consume() does, error positions are relative to [data].
+    void consume_inplace(uint8_t* data, size_t size);
+
+    // CRC mode: Every frame ends with the CRC32 of its payload (little-endian), see
+    // encode_packet_crc32(). The CRC is updated as bytes are unescaped, frames whose CRC
+    // matches are passed to the message callback WITHOUT the 4 CRC bytes, other frames
+    // are dropped (ErrorCode::DecodeCrcMismatch, LogType::CrcMismatch).
+    // Empty frames (e.g. a leading END) are ignored. Only change this between frames.
+    void setCheckCrc32(bool enable) { checkCrc32 = enable; }
+    bool checksCrc32() const { return checkCrc32; }
+
     // Clear RX buf etc
     void reset();
     
@@ -72,6 +91,20 @@ public:
     ErrorInfo getLastError() const { return lastError; }
     
 private:
+    // Append a decoded byte to the RX buffer (and the CRC in CRC mode)
+    void storeByte(uint8_t b);
+
+    // Pass a complete frame to the message callback. In CRC mode, [crc] is the CRC32 of
+    // all but the last 4 bytes of the frame, which are checked against it.
+    // @return false if the frame has been dropped due to a CRC mismatch
+    bool emitFrame(uint8_t* frame, size_t size, uint32_t crc, size_t pos);
+
+    // Clear the state of the current frame, but not lastError
+    void resetFrame();
+
+    // Record an invalid escape sequence at [pos] (lastError and log callbacks)
+    void reportInvalidEscape(size_t pos);
+
     bool lastCharIsEsc;
     uint8_t* rxbuf;
     size_t rxbufPos;
@@ -84,6 +117,10 @@ private:
     ErrorInfo lastError;
     size_t consumedCount; // Track bytes consumed for error position
 
+    // CRC mode state: CRC32 of all but the last 4 bytes in the RX buffer
+    bool checkCrc32;
+    Crc32Accumulator rxCrc;
+
     // The following are for logging only
     const char* logTag; // Tag for logging, like "ZMCU-SLIP"
 };
@@ -0,0 +1,62 @@
+/**
+ * @file Dispatch.hpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * Runtime selection of the byte-processing kernels used by the buffer API
+ * (encode, decode, length calculation) and the CRC32 functions.
+ *
+ * The best kernel supported by the CPU is detected once (using cpuid on x86)
+ * the first time any kernel is needed. It can be overridden either by calling
+ * force_kernel() or by setting the SLIPSTREAM_KERNEL environment variable
+ * to one of "scalar", "swar", "sse42" or "avx2" before the first use.
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#pragma once
+#include <cstdint>
+
+namespace SLIPStream {
+
+/**
+ * Kernel implementations, ordered from slowest to fastest
+ */
+enum class Kernel : uint8_t {
+    Auto = 0,   // Select the best kernel supported by the CPU
+    Scalar = 1, // Portable byte-at-a-time implementation
+    SWAR = 2,   // Portable 64-bit word-at-a-time implementation ("SIMD within a register")
+    SSE42 = 3,  // x86-64 with SSE4.2 & POPCNT (16 bytes per iteration)
+    AVX2 = 4    // x86-64 with AVX2 (32 bytes per iteration)
+};
+
+/**
+ * @return The kernel which is currently used
+ */
+Kernel active_kernel();
+
+/**
+ * @return The best kernel supported by this CPU (what Kernel::Auto selects)
+ */
+Kernel best_supported_kernel();
+
+/**
+ * @return true if the given kernel can be used on this CPU
+ */
+bool kernel_supported(Kernel kernel);
+
+/**
+ * Force the given kernel to be used for all subsequent operations.
+ * Use Kernel::Auto to go back to automatic selection.
+ * This is intended for testing, benchmarking and working around CPU issues,
+ * it must not be called while other threads are encoding or decoding.
+ * @return false (without changing the active kernel) if the kernel is not supported
+ */
+bool force_kernel(Kernel kernel);
+
+/**
+ * @return A human-readable name of the kernel, like "avx2"
+ */
+const char* kernel_name(Kernel kernel);
+
+} // namespace SLIPStream
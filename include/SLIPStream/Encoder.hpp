@@ -10,105 +10,41 @@
 #include <cstdint>
 #include <cstddef>
 #include <functional>
-#include <vector>
-#include "SLIPStream/SLIP.hpp"
-#include "SLIPStream/Error.hpp"
+#include <utility>
+#include "SLIPStream/BasicEncoder.hpp"
 
 namespace SLIPStream {
 
-/**
- * Non-blocking write status for the encoder's single-byte output callback
- */
-enum class WriteStatus: uint8_t {
-    Ok = 0,       // Byte accepted and written
-    RetryLater = 1, // Output would block; try again later without data loss
-    Error = 2     // Non-recoverable error from output
-};
+using OutputFn = std::function<WriteStatus(uint8_t)>;
 
 /**
- * Enhanced write status with error information
+ * Bulk output callback: Write a prefix of [data, data + length), e.g. by handing
+ * it to a UART driver or a non-blocking write().
+ * @return Status and the number of bytes written. Writing fewer bytes than offered
+ *   with WriteStatus::Ok means the output can't accept more bytes right now.
  */
-struct WriteResult {
-    WriteStatus status;
-    ErrorInfo error;
-    
-    WriteResult(WriteStatus s) : status(s), error(ErrorCode::Success) {}
-    WriteResult(ErrorCode code, size_t pos = 0, const char* msg = "")
-        : status(WriteStatus::Error), error(code, pos, msg) {}
-    
-    bool is_success() const { return status == WriteStatus::Ok; }
-    bool is_retry() const { return status == WriteStatus::RetryLater; }
-    bool is_error() const { return status == WriteStatus::Error; }
-};
+using BulkOutputFn = std::function<std::pair<WriteStatus, size_t>(const uint8_t* data, size_t length)>;
 
-using OutputFn = std::function<WriteStatus(uint8_t)>;
+// Compiled into the library (Encoder.cpp)
+extern template class BasicEncoder<BulkOutputFn, DynamicCapacity>;
 
 /**
  * A stateful, non-blocking SLIP encoder with internal buffering.
+ * Uses std::function output callbacks and a heap-allocated queue of any size,
+ * see BasicEncoder for an encoder without either.
  */
-class Encoder {
+class Encoder : public BasicEncoder<BulkOutputFn, DynamicCapacity> {
 public:
+    // Per-byte output: outputFn is called for every encoded byte
     Encoder(OutputFn outputFn, size_t txBufferSize, size_t maxSendChunk = 64);
 
-    // Attempt to flush up to maxSendChunk queued encoded bytes via outputFn.
-    WriteStatus flush();
-    
-    // Enhanced flush with error information
-    WriteResult flush_ex();
-
-    // Encode and queue a complete SLIP packet (payload escaped, END appended).
-    // Returns pair of (status, consumedBytes).
-    std::pair<WriteStatus, size_t> pushPacket(const uint8_t* data, size_t size);
-    
-    // Encode and queue a complete SLIP packet with chunk-based processing
-    // Processes data in chunks of specified size for better performance
-    std::pair<WriteStatus, size_t> pushPacket_chunk(const uint8_t* data, size_t size, size_t chunk_size);
-    
-    // Enhanced pushPacket with detailed error information
-    struct PushPacketResult {
-        WriteStatus status;
-        size_t consumed;
-        ErrorInfo error;
-        
-        PushPacketResult(WriteStatus s, size_t c) : status(s), consumed(c), error(ErrorCode::Success) {}
-        PushPacketResult(ErrorCode code, size_t c, size_t pos = 0, const char* msg = "")
-            : status(WriteStatus::Error), consumed(c), error(code, pos, msg) {}
-        
-        bool is_success() const { return status == WriteStatus::Ok; }
-        bool is_retry() const { return status == WriteStatus::RetryLater; }
-        bool is_error() const { return status == WriteStatus::Error; }
-    };
-    PushPacketResult pushPacket_ex(const uint8_t* data, size_t size);
-    
-    // Enhanced chunk-based pushPacket with detailed error information
-    PushPacketResult pushPacket_chunk_ex(const uint8_t* data, size_t size, size_t chunk_size);
-
-    void setMaxSendChunk(size_t n) { maxSendChunk = n; }
-
-    size_t queued() const { return txSize; }
-    size_t capacity() const { return txBuf.size(); }
-    size_t free() const { return txBuf.size() - txSize; }
-
-private:
-    // Internal helpers for queue management
-    bool queueByte(uint8_t b);
-    bool dequeueByte(uint8_t& b);
-
-    // Try to ensure at least 'n' bytes free in queue by flushing as needed
-    WriteStatus ensureFree(size_t n);
-
-    // Encode one payload byte into queue (may be 1 or 2 bytes)
-    WriteStatus encodeOne(const uint8_t* data, size_t size, size_t& consumed);
-
-    OutputFn outputFn;
-    std::vector<uint8_t> txBuf;
-    size_t txHead; // pop index
-    size_t txTail; // push index
-    size_t txSize; // number of bytes currently queued
-    size_t maxSendChunk;
+    // Bulk output: outputFn is called with contiguous runs of queued bytes (up to
+    // maxSendChunk bytes per flush), at most two calls when the queue wraps around.
+    Encoder(BulkOutputFn outputFn, size_t txBufferSize, size_t maxSendChunk = 64);
 
-    // Packet state: whether we still need to append a trailing END for the current packet
-    bool endPending;
+    // Queue only: No output function, take the encoded bytes out of the queue
+    // using readable_segments() and consume(). flush() only queues a pending packet trailer.
+    explicit Encoder(size_t txBufferSize);
 };
 
-} // namespace SLIPStream
\ No newline at end of file
+} // namespace SLIPStream
@@ -24,6 +24,7 @@ enum class ErrorCode : uint8_t {
     // Encoding errors
     EncodeBufferTooSmall = 10,
     EncodeInternalError = 11,
+    EncodeInvalidPacketState = 12,
     
     // Decoding errors
     DecodeBufferTooSmall = 20,
@@ -31,6 +32,7 @@ enum class ErrorCode : uint8_t {
     DecodeInvalidEscapeSequence = 22,
     DecodeTruncatedEscape = 23,
     DecodeInternalError = 24,
+    DecodeCrcMismatch = 25,
     
     // Buffer errors
     RXBufferOverflow = 30,
@@ -10,6 +10,7 @@
  */
 #pragma once
 #include <cstdint>
+#include <cstddef>
 
 namespace SLIPStream {
 
@@ -19,4 +20,14 @@ inline constexpr uint8_t ESC    = 0xDB; // Escape character
 inline constexpr uint8_t ESCEND = 0xDC; // Escaped END data byte
 inline constexpr uint8_t ESCESC = 0xDD; // Escaped ESC data byte
 
+/**
+ * One contiguous piece of a packet for scatter-gather (vectored) encoding,
+ * like struct iovec. The segments of a packet are encoded in order as if
+ * they were concatenated.
+ */
+struct Segment {
+    const uint8_t* data;
+    size_t length;
+};
+
 } // namespace SLIPStream
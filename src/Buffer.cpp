@@ -1,47 +1,75 @@
 #include "SLIPStream/SLIP.hpp"
 #include "SLIPStream/Buffer.hpp"
 #include "SLIPStream/Error.hpp"
+#include "SLIPStream/CRC32.hpp"
+#include "Kernels.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace SLIPStream {
 
 size_t encoded_length(const uint8_t* in, size_t inlen) {
-	// This variable contains the length of the data
-	size_t outlen = 0;
-	const uint8_t* inend = in + inlen; // First character AFTER the
-	for (; in < inend ; in++) {
-		switch (*in) {
-		case END: // Need to escape END character to avoid RX seeing end of frame
-			// Same as "case SLIP_ESC" so just continue.
-		case ESC: // Need to escape ESC character, we'll send
-			outlen += 2; // Will send ESC + ESCESC
-			break;
-		default: // Any other character => will just copy
-			outlen++; // Will only send the given character
-		}
-	}
+	// Every byte is sent once, END & ESC bytes are sent as two-byte escape sequences
+	size_t outlen = inlen + detail::kernels().count_special(in, inlen);
 	// + 1: SLIP END bytes
 	return outlen + 1;
 }
 
 Result<size_t> encoded_length_ex(const uint8_t* in, size_t inlen) {
-	// This variable contains the length of the data
-	size_t outlen = 0;
-	const uint8_t* inend = in + inlen; // First character AFTER the
-	for (; in < inend ; in++) {
-		switch (*in) {
-		case END: // Need to escape END character to avoid RX seeing end of frame
-			// Same as "case SLIP_ESC" so just continue.
-		case ESC: // Need to escape ESC character, we'll send
-			outlen += 2; // Will send ESC + ESCESC
+	// Every byte is sent once, END & ESC bytes are sent as two-byte escape sequences
+	size_t outlen = inlen + detail::kernels().count_special(in, inlen);
+	// + 1: SLIP END bytes
+	return Result<size_t>(outlen + 1);
+}
+
+namespace {
+
+/**
+ * Escape [in, inend) into [out, outend), shared by all bounds-checked encode functions.
+ * One byte of [out] is always kept free for the trailing END, which is NOT written.
+ * On error, [in] points to the first input byte which does not fit.
+ * @param message Set to a description of the error (on error only)
+ * @return ErrorCode::Success or ErrorCode::EncodeBufferTooSmall
+ */
+ErrorCode encode_segment(const detail::KernelTable& kernels, const uint8_t*& in, const uint8_t* inend,
+                         uint8_t*& out, uint8_t* outend, const char*& message) {
+	// Fast path for the bulk of the data, the loop below handles the remainder
+	kernels.encode_bulk(in, inend, out, outend);
+	while (in < inend) {
+		// Copy the run of bytes which do not need escaping in one go
+		const uint8_t* special = kernels.find_special(in, inend);
+		size_t run = static_cast<size_t>(special - in);
+		if (run > 0) {
+			// Check out of bounds memory access (one byte is reserved for END)
+			size_t avail = static_cast<size_t>(outend - out) - 1;
+			if(run > avail) {
+				// The first data byte which does not fit is the one at [in + avail]
+				in += avail;
+				message = "Output buffer too small for data byte";
+				return ErrorCode::EncodeBufferTooSmall;
+			}
+			memcpy(out, in, run);
+			out += run;
+			in = special;
+		}
+		if (in == inend) {
 			break;
-		default: // Any other character => will just copy
-			outlen++; // Will only send the given character
 		}
+		// [in] now points to an END or ESC byte which needs to be escaped
+		// Check out of bounds memory access
+		if(outend - out <= 2) {
+			message = (*in == END) ? "Output buffer too small for escaped END" : "Output buffer too small for escaped ESC";
+			return ErrorCode::EncodeBufferTooSmall;
+		}
+		*out++ = ESC;
+		*out++ = (*in == END) ? ESCEND : ESCESC;
+		in++;
 	}
-	// + 1: SLIP END bytes
-	return Result<size_t>(outlen + 1);
+	return ErrorCode::Success;
 }
 
+} // namespace
+
 size_t encode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
 	// This variable contains the length of the data
 	uint8_t* out_start = out; // We will increment [out], hence copy the original value.
@@ -50,41 +78,17 @@ size_t encode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outle
 	if(outlen < inlen) {
 		return ENCODE_ERROR;
 	}
+	// Check out of bounds access for END byte
+	if(outlen == 0) {
+		return ENCODE_ERROR;
+	}
 
 	uint8_t* outend = out + outlen; // First character AFTER the
-	const uint8_t* inend = in + inlen; // First character AFTER the
-	for (; in < inend ; in++) {
-		switch (*in) {
-		case END: // Need to escape END character to avoid RX seeing end of frame
-			// Check out of bounds memory acces
-			if(out + 2 >= outend) {
-				return ENCODE_ERROR;
-			}
-			// Copy escaped END character
-			*out++ = ESC;
-			*out++ = ESCEND;
-			break;
-		case ESC: // Need to escape ESC character, we'll send
-			// Check out of bounds memory access
-			if(out + 2 >= outend) {
-				return ENCODE_ERROR;
-			}
-			// Copy escaped END character
-			*out++ = ESC;
-			*out++ = ESCESC;
-			break;
-		default: // Any other character => just copy the character
-			if(out + 1 >= outend) {
-				return ENCODE_ERROR;
-			}
-			*out++ = *in;
-		}
-	}
-	// Check out of bounds access for END byte
-	if(out + 1 > outend) { // NOTE: > instead of >= since there is only ONE character to be written
+	const char* message;
+	if (encode_segment(detail::kernels(), in, in + inlen, out, outend, message) != ErrorCode::Success) {
 		return ENCODE_ERROR;
 	}
-	// Insert END byte
+	// Insert END byte (encode_segment() always leaves room for it)
 	*out++ = END;
 	// Return number of bytes
 	return (out - out_start);
@@ -93,78 +97,196 @@ size_t encode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outle
 Result<size_t> encode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
 	// This variable contains the length of the data
 	uint8_t* out_start = out; // We will increment [out], hence copy the original value.
+	const uint8_t* in_start = in; // Used to compute error positions
 
 	// Output buffer must be AT LEAST as long as input data (sanity check)
 	if(outlen < inlen) {
 		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, 0, "Output buffer too small");
 	}
+	// Check out of bounds access for END byte
+	if(outlen == 0) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, 0, "Output buffer too small for END byte");
+	}
 
 	uint8_t* outend = out + outlen; // First character AFTER the
-	const uint8_t* inend = in + inlen; // First character AFTER the
-	size_t pos = 0;
-	for (; in < inend ; in++) {
-		switch (*in) {
-		case END: // Need to escape END character to avoid RX seeing end of frame
-			// Check out of bounds memory acces
-			if(out + 2 >= outend) {
-				return Result<size_t>(ErrorCode::EncodeBufferTooSmall, pos, "Output buffer too small for escaped END");
-			}
-			// Copy escaped END character
-			*out++ = ESC;
-			*out++ = ESCEND;
-			break;
-		case ESC: // Need to escape ESC character, we'll send
-			// Check out of bounds memory access
-			if(out + 2 >= outend) {
-				return Result<size_t>(ErrorCode::EncodeBufferTooSmall, pos, "Output buffer too small for escaped ESC");
-			}
-			// Copy escaped END character
-			*out++ = ESC;
-			*out++ = ESCESC;
+	const char* message = "";
+	if (encode_segment(detail::kernels(), in, in + inlen, out, outend, message) != ErrorCode::Success) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, static_cast<size_t>(in - in_start), message);
+	}
+	// Insert END byte (encode_segment() always leaves room for it)
+	*out++ = END;
+	// Return number of bytes
+	return Result<size_t>(out - out_start);
+}
+
+size_t encoded_lengthv(const Segment* segments, size_t count) {
+	size_t outlen = 1; // END byte
+	const detail::KernelTable& kernels = detail::kernels();
+	for (size_t i = 0; i < count; i++) {
+		outlen += segments[i].length + kernels.count_special(segments[i].data, segments[i].length);
+	}
+	return outlen;
+}
+
+size_t encode_packetv(const Segment* segments, size_t count, uint8_t* out, size_t outlen) {
+	Result<size_t> result = encode_packetv_ex(segments, count, out, outlen);
+	return result.is_success() ? result.value : ENCODE_ERROR;
+}
+
+Result<size_t> encode_packetv_ex(const Segment* segments, size_t count, uint8_t* out, size_t outlen) {
+	uint8_t* out_start = out;
+	uint8_t* outend = out + outlen;
+	if(outlen == 0) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, 0, "Output buffer too small for END byte");
+	}
+	const detail::KernelTable& kernels = detail::kernels();
+	size_t offset = 0; // Offset of the current segment in the concatenated input (for error positions)
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t* in = segments[i].data;
+		const char* message = "";
+		if (encode_segment(kernels, in, in + segments[i].length, out, outend, message) != ErrorCode::Success) {
+			return Result<size_t>(ErrorCode::EncodeBufferTooSmall, offset + static_cast<size_t>(in - segments[i].data), message);
+		}
+		offset += segments[i].length;
+	}
+	// Insert END byte (encode_segment() always leaves room for it)
+	*out++ = END;
+	return Result<size_t>(static_cast<size_t>(out - out_start));
+}
+
+namespace {
+
+/**
+ * Encode [in] into [out] without any bounds checks.
+ * [out] must have room for max_encoded_length(inlen) bytes.
+ * @return The number of bytes written to [out], including END
+ */
+size_t encode_unchecked(const uint8_t* in, size_t inlen, uint8_t* out) {
+	uint8_t* out_start = out;
+	const uint8_t* inend = in + inlen; // First character AFTER the input
+	// The bulk kernel still checks its bounds once per block, pass the worst case end
+	const detail::KernelTable& kernels = detail::kernels();
+	kernels.encode_bulk(in, inend, out, out + max_encoded_length(static_cast<size_t>(inend - in)));
+	while (in < inend) {
+		// Copy the run of bytes which do not need escaping in one go
+		const uint8_t* special = kernels.find_special(in, inend);
+		size_t run = static_cast<size_t>(special - in);
+		memcpy(out, in, run);
+		out += run;
+		in = special;
+		if (in == inend) {
 			break;
-		default: // Any other character => just copy the character
-			if(out + 1 >= outend) {
-				return Result<size_t>(ErrorCode::EncodeBufferTooSmall, pos, "Output buffer too small for data byte");
-			}
-			*out++ = *in;
 		}
-		pos++;
+		// [in] now points to an END or ESC byte which needs to be escaped
+		*out++ = ESC;
+		*out++ = (*in == END) ? ESCEND : ESCESC;
+		in++;
 	}
-	// Check out of bounds access for END byte
-	if(out + 1 > outend) { // NOTE: > instead of >= since there is only ONE character to be written
-		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, pos, "Output buffer too small for END byte");
+	*out++ = END;
+	return static_cast<size_t>(out - out_start);
+}
+
+/**
+ * @return true if [outlen] can hold the worst case encoding of [inlen] bytes
+ */
+inline bool fits_max_encoded_length(size_t inlen, size_t outlen) {
+	// Prevent 2 * inlen + 1 from overflowing
+	return inlen <= (SIZE_MAX - 1) / 2 && outlen >= max_encoded_length(inlen);
+}
+
+} // namespace
+
+size_t encode_packet_max(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	if (!fits_max_encoded_length(inlen, outlen)) {
+		return ENCODE_ERROR;
+	}
+	return encode_unchecked(in, inlen, out);
+}
+
+Result<size_t> encode_packet_max_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	if (!fits_max_encoded_length(inlen, outlen)) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, 0, "Output buffer smaller than max_encoded_length()");
+	}
+	return Result<size_t>(encode_unchecked(in, inlen, out));
+}
+
+namespace {
+
+// Block size of the fused CRC32 + encode/decode loops: Every block is still in
+// the L1 cache when the CRC is updated right before (encode) or after (decode) escaping it
+constexpr size_t CRC32_FUSED_BLOCK = 2048;
+
+} // namespace
+
+size_t encode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	Result<size_t> result = encode_packet_crc32_ex(in, inlen, out, outlen);
+	return result.is_success() ? result.value : ENCODE_ERROR;
+}
+
+Result<size_t> encode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	uint8_t* out_start = out;
+	uint8_t* outend = out + outlen;
+	if(outlen == 0) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, 0, "Output buffer too small for END byte");
 	}
-	// Insert END byte
+	const detail::KernelTable& kernels = detail::kernels();
+	const uint8_t* p = in;
+	const uint8_t* inend = in + inlen;
+	const char* message = "";
+	uint32_t crc = 0xFFFFFFFF; // Same initial value as calculate_crc32()
+	while (p < inend) {
+		const uint8_t* blockend = p + std::min(CRC32_FUSED_BLOCK, static_cast<size_t>(inend - p));
+		crc = kernels.crc32_update(crc, p, static_cast<size_t>(blockend - p));
+		if (encode_segment(kernels, p, blockend, out, outend, message) != ErrorCode::Success) {
+			return Result<size_t>(ErrorCode::EncodeBufferTooSmall, static_cast<size_t>(p - in), message);
+		}
+	}
+	// Append CRC in little-endian format (LSB first), escaped like the payload
+	uint8_t trailer[4] = {
+		static_cast<uint8_t>(crc & 0xFF),
+		static_cast<uint8_t>((crc >> 8) & 0xFF),
+		static_cast<uint8_t>((crc >> 16) & 0xFF),
+		static_cast<uint8_t>((crc >> 24) & 0xFF)
+	};
+	const uint8_t* t = trailer;
+	if (encode_segment(kernels, t, trailer + sizeof(trailer), out, outend, message) != ErrorCode::Success) {
+		return Result<size_t>(ErrorCode::EncodeBufferTooSmall, inlen + static_cast<size_t>(t - trailer), message);
+	}
+	// Insert END byte (encode_segment() always leaves room for it)
 	*out++ = END;
-	// Return number of bytes
-	return Result<size_t>(out - out_start);
+	return Result<size_t>(static_cast<size_t>(out - out_start));
 }
 
 size_t decoded_length(const uint8_t* in, size_t inlen) {
+	const detail::KernelTable& kernels = detail::kernels();
 	const uint8_t* p = in;
 	const uint8_t* end = in + inlen;
 	size_t outlen = 0;
 	bool saw_end = false;
 	while (p < end) {
+		// Skip the run of bytes which are copied verbatim
+		const uint8_t* special = kernels.find_special(p, end);
+		outlen += static_cast<size_t>(special - p);
+		p = special;
+		if (p == end) {
+			break;
+		}
 		uint8_t c = *p++;
 		if (c == END) { // End of packet
 			saw_end = true;
 			break;
 		}
-		if (c == ESC) {
-			if (p >= end) {
-				// ESC must be followed by a byte
-				return DECODE_ERROR;
-			}
-			uint8_t n = *p++;
-			if (n == ESCEND || n == ESCESC) {
-				outlen += 1;
-			} else {
-				// Invalid escape sequence
-				return DECODE_ERROR;
-			}
-		} else {
+		// c == ESC
+		if (p >= end) {
+			// ESC must be followed by a byte
+			return DECODE_ERROR;
+		}
+		uint8_t n = *p++;
+		if (n == ESCEND || n == ESCESC) {
 			outlen += 1;
+		} else {
+			// Invalid escape sequence
+			return DECODE_ERROR;
 		}
 	}
 	if (!saw_end) {
@@ -175,127 +297,358 @@ size_t decoded_length(const uint8_t* in, size_t inlen) {
 }
 
 Result<size_t> decoded_length_ex(const uint8_t* in, size_t inlen) {
+	const detail::KernelTable& kernels = detail::kernels();
 	const uint8_t* p = in;
 	const uint8_t* end = in + inlen;
-	size_t outlen = 0;
+	size_t outlen = 0; // Also the error position: the index of the next decoded byte
 	bool saw_end = false;
-	size_t pos = 0;
 	while (p < end) {
+		// Skip the run of bytes which are copied verbatim
+		const uint8_t* special = kernels.find_special(p, end);
+		outlen += static_cast<size_t>(special - p);
+		p = special;
+		if (p == end) {
+			break;
+		}
 		uint8_t c = *p++;
 		if (c == END) { // End of packet
 			saw_end = true;
 			break;
 		}
-		if (c == ESC) {
-			if (p >= end) {
-				// ESC must be followed by a byte
-				return Result<size_t>(ErrorCode::DecodeTruncatedEscape, pos, "Truncated escape sequence at end of input");
-			}
-			uint8_t n = *p++;
-			if (n == ESCEND || n == ESCESC) {
-				outlen += 1;
-			} else {
-				// Invalid escape sequence
-				return Result<size_t>(ErrorCode::DecodeInvalidEscapeSequence, pos, "Invalid escape sequence: ESC not followed by ESCEND or ESCESC");
-			}
-		} else {
+		// c == ESC
+		if (p >= end) {
+			// ESC must be followed by a byte
+			return Result<size_t>(ErrorCode::DecodeTruncatedEscape, outlen, "Truncated escape sequence at end of input");
+		}
+		uint8_t n = *p++;
+		if (n == ESCEND || n == ESCESC) {
 			outlen += 1;
+		} else {
+			// Invalid escape sequence
+			return Result<size_t>(ErrorCode::DecodeInvalidEscapeSequence, outlen, "Invalid escape sequence: ESC not followed by ESCEND or ESCESC");
 		}
-		pos++;
 	}
 	if (!saw_end) {
 		// No END found
-		return Result<size_t>(ErrorCode::DecodeNoEndMarker, pos, "No END marker (0xC0) found in input data");
+		return Result<size_t>(ErrorCode::DecodeNoEndMarker, outlen, "No END marker (0xC0) found in input data");
 	}
 	return Result<size_t>(outlen);
 }
 
-size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
-	const uint8_t* p = in;
-	const uint8_t* end = in + inlen;
-	uint8_t* w = out;
-	uint8_t* wend = out + outlen;
-	bool saw_end = false;
+namespace {
 
+/**
+ * Decode one frame from [p, end) into [w, wend), shared by all decode functions.
+ * On success, [p] points after the END byte and [w] after the last decoded byte.
+ * On error, [w] - out is the error position: the index of the next decoded byte,
+ * or wend if a run of data bytes does not fit into the output buffer.
+ * @param message Set to a description of the error (on error only)
+ * @return ErrorCode::Success or the decode error
+ */
+ErrorCode decode_frame(const detail::KernelTable& kernels, const uint8_t*& p, const uint8_t* end,
+                       uint8_t*& w, uint8_t* wend, const char*& message) {
+	// Fast path for the bulk of the data, the loop below handles the remainder
+	kernels.decode_bulk(p, end, w, wend);
 	while (p < end) {
+		// Copy the run of bytes which do not need unescaping in one go
+		const uint8_t* special = kernels.find_special(p, end);
+		size_t run = static_cast<size_t>(special - p);
+		if (run > static_cast<size_t>(wend - w)) {
+			// The first byte which does not fit would be written at wend
+			w = wend;
+			message = "Output buffer too small for data byte";
+			return ErrorCode::DecodeBufferTooSmall;
+		}
+		if (run > 0) {
+			// memcpy() needs valid pointers even for 0 bytes, but an empty output may be nullptr
+			memcpy(w, p, run);
+			w += run;
+		}
+		p = special;
+		if (p == end) {
+			break;
+		}
 		uint8_t c = *p++;
 		if (c == END) {
-			saw_end = true;
-			break; // End of packet
+			return ErrorCode::Success; // End of packet
 		}
-		if (c == ESC) {
-			if (p >= end) {
-				return DECODE_ERROR; // Truncated escape
-			}
-			uint8_t n = *p++;
-			uint8_t decoded;
-			if (n == ESCEND) {
-				decoded = END;
-			} else if (n == ESCESC) {
-				decoded = ESC;
-			} else {
-				return DECODE_ERROR; // Invalid escape sequence
-			}
-			if (w >= wend) {
-				return DECODE_ERROR; // Output buffer too small
-			}
-			*w++ = decoded;
+		// c == ESC
+		if (p >= end) {
+			message = "Truncated escape sequence at end of input";
+			return ErrorCode::DecodeTruncatedEscape;
+		}
+		uint8_t n = *p++;
+		uint8_t decoded;
+		if (n == ESCEND) {
+			decoded = END;
+		} else if (n == ESCESC) {
+			decoded = ESC;
 		} else {
-			if (w >= wend) {
-				return DECODE_ERROR; // Output buffer too small
-			}
-			*w++ = c;
+			message = "Invalid escape sequence: ESC not followed by ESCEND or ESCESC";
+			return ErrorCode::DecodeInvalidEscapeSequence;
 		}
+		if (w >= wend) {
+			message = "Output buffer too small for decoded data";
+			return ErrorCode::DecodeBufferTooSmall;
+		}
+		*w++ = decoded;
 	}
-	if (!saw_end) {
-		return DECODE_ERROR; // No END terminator found
+	message = "No END terminator found in input data";
+	return ErrorCode::DecodeNoEndMarker;
+}
+
+} // namespace
+
+size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed) {
+	const uint8_t* p = in;
+	uint8_t* w = out;
+	const char* message;
+	if (decode_frame(detail::kernels(), p, in + inlen, w, out + outlen, message) != ErrorCode::Success) {
+		return DECODE_ERROR;
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - in); // Including END
 	}
 	return static_cast<size_t>(w - out);
 }
 
+size_t decode_packet(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	return decode_packet(in, inlen, out, outlen, nullptr);
+}
+
+Result<size_t> decode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed) {
+	const uint8_t* p = in;
+	uint8_t* w = out;
+	const char* message = "";
+	ErrorCode code = decode_frame(detail::kernels(), p, in + inlen, w, out + outlen, message);
+	// NOTE: The error position is the index of the next decoded byte, i.e. (w - out)
+	size_t pos = static_cast<size_t>(w - out);
+	if (code != ErrorCode::Success) {
+		return Result<size_t>(code, pos, message);
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - in); // Including END
+	}
+	return Result<size_t>(pos);
+}
+
 Result<size_t> decode_packet_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	return decode_packet_ex(in, inlen, out, outlen, nullptr);
+}
+
+namespace {
+
+/**
+ * Decode the frame [p, end) to [w, wend) like decode_frame() and compute the
+ * CRC32 of the decoded bytes except for the last 4 (the CRC trailer).
+ * The input is decoded in blocks of CRC32_FUSED_BLOCK bytes, and the CRC is
+ * updated right after each block while the decoded bytes are still in the L1 cache.
+ * Since the trailer is only known at the END, the CRC lags 4 bytes behind.
+ */
+ErrorCode decode_frame_crc32(const detail::KernelTable& kernels, const uint8_t*& p, const uint8_t* end,
+                             uint8_t*& w, uint8_t* wend, uint32_t& crc, const char*& message) {
+	uint8_t* crcpos = w; // Decoded bytes before crcpos have been added to the CRC
+	crc = 0xFFFFFFFF; // Same initial value as calculate_crc32()
+	while (true) {
+		const uint8_t* blockend = p + std::min(CRC32_FUSED_BLOCK, static_cast<size_t>(end - p));
+		ErrorCode code = decode_frame(kernels, p, blockend, w, wend, message);
+		if (code == ErrorCode::DecodeTruncatedEscape && blockend != end) {
+			// The escape sequence is split by the block boundary: Resume at the ESC
+			p--;
+			code = ErrorCode::DecodeNoEndMarker;
+		}
+		if (w - crcpos > 4) {
+			crc = kernels.crc32_update(crc, crcpos, static_cast<size_t>(w - crcpos) - 4);
+			crcpos = w - 4;
+		}
+		if (code != ErrorCode::DecodeNoEndMarker || blockend == end) {
+			return code;
+		}
+	}
+}
+
+/**
+ * @return true if the last 4 bytes of the decoded frame [out, w) match [crc]
+ */
+inline bool frame_crc32_matches(const uint8_t* out, const uint8_t* w, uint32_t crc) {
+	if (w - out < 4) {
+		return false;
+	}
+	uint32_t stored_crc;
+	extract_crc32(out, static_cast<size_t>(w - out), &stored_crc);
+	return stored_crc == crc;
+}
+
+} // namespace
+
+size_t decode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed) {
 	const uint8_t* p = in;
-	const uint8_t* end = in + inlen;
 	uint8_t* w = out;
-	uint8_t* wend = out + outlen;
-	bool saw_end = false;
-	size_t pos = 0;
+	uint32_t crc;
+	const char* message;
+	if (decode_frame_crc32(detail::kernels(), p, in + inlen, w, out + outlen, crc, message) != ErrorCode::Success) {
+		return DECODE_ERROR;
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - in); // Including END
+	}
+	if (!frame_crc32_matches(out, w, crc)) {
+		return DECODE_ERROR;
+	}
+	return static_cast<size_t>(w - out) - 4;
+}
+
+size_t decode_packet_crc32(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	return decode_packet_crc32(in, inlen, out, outlen, nullptr);
+}
+
+Result<size_t> decode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen, size_t* consumed) {
+	const uint8_t* p = in;
+	uint8_t* w = out;
+	uint32_t crc;
+	const char* message = "";
+	ErrorCode code = decode_frame_crc32(detail::kernels(), p, in + inlen, w, out + outlen, crc, message);
+	if (code != ErrorCode::Success) {
+		// NOTE: The error position is the index of the next decoded byte, i.e. (w - out)
+		return Result<size_t>(code, static_cast<size_t>(w - out), message);
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - in); // Including END
+	}
+	if (w - out < 4) {
+		return Result<size_t>(ErrorCode::DecodeCrcMismatch, 0, "Frame too short for CRC32 trailer");
+	}
+	size_t payload_length = static_cast<size_t>(w - out) - 4;
+	if (!frame_crc32_matches(out, w, crc)) {
+		return Result<size_t>(ErrorCode::DecodeCrcMismatch, payload_length, "CRC32 mismatch");
+	}
+	return Result<size_t>(payload_length);
+}
+
+Result<size_t> decode_packet_crc32_ex(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen) {
+	return decode_packet_crc32_ex(in, inlen, out, outlen, nullptr);
+}
+
+namespace {
 
+/**
+ * In-place variant of decode_frame(): Decodes [p, end) to [w, ...) where w <= p.
+ * Since the write position never overtakes the read position, runs are moved using
+ * memmove() instead of the (non overlap-safe) vector kernels.
+ */
+ErrorCode decode_frame_inplace(const detail::KernelTable& kernels, uint8_t*& p, const uint8_t* end,
+                               uint8_t*& w, const char*& message) {
 	while (p < end) {
+		// Copy the run of bytes which do not need unescaping in one go
+		size_t run = static_cast<size_t>(kernels.find_special(p, end) - p);
+		if (w != p) { // Nothing to move before the first escape sequence
+			memmove(w, p, run);
+		}
+		w += run;
+		p += run;
+		if (p == end) {
+			break;
+		}
 		uint8_t c = *p++;
 		if (c == END) {
-			saw_end = true;
-			break; // End of packet
+			return ErrorCode::Success; // End of packet
 		}
-		if (c == ESC) {
-			if (p >= end) {
-				return Result<size_t>(ErrorCode::DecodeTruncatedEscape, pos, "Truncated escape sequence at end of input");
-			}
-			uint8_t n = *p++;
-			uint8_t decoded;
-			if (n == ESCEND) {
-				decoded = END;
-			} else if (n == ESCESC) {
-				decoded = ESC;
-			} else {
-				return Result<size_t>(ErrorCode::DecodeInvalidEscapeSequence, pos, "Invalid escape sequence: ESC not followed by ESCEND or ESCESC");
+		// c == ESC
+		if (p >= end) {
+			message = "Truncated escape sequence at end of input";
+			return ErrorCode::DecodeTruncatedEscape;
+		}
+		uint8_t n = *p++;
+		if (n == ESCEND) {
+			*w++ = END;
+		} else if (n == ESCESC) {
+			*w++ = ESC;
+		} else {
+			message = "Invalid escape sequence: ESC not followed by ESCEND or ESCESC";
+			return ErrorCode::DecodeInvalidEscapeSequence;
+		}
+	}
+	message = "No END terminator found in input data";
+	return ErrorCode::DecodeNoEndMarker;
+}
+
+} // namespace
+
+size_t decode_packet_inplace(uint8_t* buf, size_t len, size_t* consumed) {
+	uint8_t* p = buf;
+	uint8_t* w = buf;
+	const char* message;
+	if (decode_frame_inplace(detail::kernels(), p, buf + len, w, message) != ErrorCode::Success) {
+		return DECODE_ERROR;
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - buf); // Including END
+	}
+	return static_cast<size_t>(w - buf);
+}
+
+size_t decode_packet_inplace(uint8_t* buf, size_t len) {
+	return decode_packet_inplace(buf, len, nullptr);
+}
+
+Result<size_t> decode_packet_inplace_ex(uint8_t* buf, size_t len, size_t* consumed) {
+	uint8_t* p = buf;
+	uint8_t* w = buf;
+	const char* message = "";
+	ErrorCode code = decode_frame_inplace(detail::kernels(), p, buf + len, w, message);
+	// NOTE: The error position is the index of the next decoded byte, like decode_packet_ex()
+	size_t pos = static_cast<size_t>(w - buf);
+	if (code != ErrorCode::Success) {
+		return Result<size_t>(code, pos, message);
+	}
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - buf); // Including END
+	}
+	return Result<size_t>(pos);
+}
+
+Result<size_t> decode_packet_inplace_ex(uint8_t* buf, size_t len) {
+	return decode_packet_inplace_ex(buf, len, nullptr);
+}
+
+size_t decode_all_packets(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen,
+                          FrameRef* frames, size_t max_frames, size_t* consumed) {
+	const detail::KernelTable& kernels = detail::kernels();
+	const uint8_t* p = in;
+	const uint8_t* end = in + inlen;
+	uint8_t* w = out; // Next free byte in the output arena
+	uint8_t* wend = out + outlen;
+	size_t nframes = 0;
+	while (p < end && nframes < max_frames) {
+		const uint8_t* frame_start = p;
+		uint8_t* frame_out = w;
+		const char* message;
+		ErrorCode code = decode_frame(kernels, p, end, w, wend, message);
+		if (code == ErrorCode::Success) {
+			if (w != frame_out) { // Skip empty frames
+				frames[nframes].offset = static_cast<size_t>(frame_out - out);
+				frames[nframes].length = static_cast<size_t>(w - frame_out);
+				nframes++;
 			}
-			if (w >= wend) {
-				return Result<size_t>(ErrorCode::DecodeBufferTooSmall, pos, "Output buffer too small for decoded data");
+		} else if (code == ErrorCode::DecodeInvalidEscapeSequence) {
+			// Drop the malformed frame: END can't occur within a frame, so it ends at the next END
+			w = frame_out;
+			const uint8_t* frame_end = static_cast<const uint8_t*>(memchr(frame_start, END, static_cast<size_t>(end - frame_start)));
+			if (frame_end == nullptr) {
+				p = frame_start; // Not terminated yet, will be dropped once the rest has been received
+				break;
 			}
-			*w++ = decoded;
+			p = frame_end + 1;
 		} else {
-			if (w >= wend) {
-				return Result<size_t>(ErrorCode::DecodeBufferTooSmall, pos, "Output buffer too small for data byte");
-			}
-			*w++ = c;
+			// Incomplete frame at the end of the input or output arena full
+			p = frame_start;
+			break;
 		}
-		pos++;
 	}
-	if (!saw_end) {
-		return Result<size_t>(ErrorCode::DecodeNoEndMarker, pos, "No END terminator found in input data");
+	if (consumed != nullptr) {
+		*consumed = static_cast<size_t>(p - in);
 	}
-	return Result<size_t>(static_cast<size_t>(w - out));
+	return nframes;
 }
 
 } // namespace SLIPStream
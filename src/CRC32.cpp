@@ -9,61 +9,453 @@
  * @copyright Copyright (C) 2022..2025 Uli Köhler
  */
 #include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Crc.hpp"
+#include "Kernels.hpp"
+#include <algorithm>
+#include <array>
+#if !defined(SLIPSTREAM_NO_THREADS)
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
+// Exceptions are disabled e.g. by -fno-exceptions (the ESP-IDF default)
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define SLIPSTREAM_EXCEPTIONS 1
+#endif
 
 namespace SLIPStream {
 
 // CRC32 polynomial (Ethernet polynomial)
 constexpr uint32_t CRC32_POLYNOMIAL = 0x04C11DB7;
 
-// Pre-computed CRC32 lookup table (matching Python implementation)
-static const uint32_t crc32_table[256] = {
-    0x00000000, 0x09823B6E, 0x130476DC, 0x1A864DB2, 0x2608EDB8, 0x2F8AD6D6, 0x350C9B64, 0x3C8EA00A,
-    0x4C11DB70, 0x4593E01E, 0x5F15ADAC, 0x569796C2, 0x6A1936C8, 0x639B0DA6, 0x791D4014, 0x709F7B7A,
-    0x9823B6E0, 0x91A18D8E, 0x8B27C03C, 0x82A5FB52, 0xBE2B5B58, 0xB7A96036, 0xAD2F2D84, 0xA4AD16EA,
-    0xD4326D90, 0xDDB056FE, 0xC7361B4C, 0xCEB42022, 0xF23A8028, 0xFBB8BB46, 0xE13EF6F4, 0xE8BCCD9A,
-    0x39C556AE, 0x30476DC0, 0x2AC12072, 0x23431B1C, 0x1FCDBB16, 0x164F8078, 0x0CC9CDCA, 0x054BF6A4,
-    0x75D48DDE, 0x7C56B6B0, 0x66D0FB02, 0x6F52C06C, 0x53DC6066, 0x5A5E5B08, 0x40D816BA, 0x495A2DD4,
-    0xA1E6E04E, 0xA864DB20, 0xB2E29692, 0xBB60ADFC, 0x87EE0DF6, 0x8E6C3698, 0x94EA7B2A, 0x9D684044,
-    0xEDF73B3E, 0xE4750050, 0xFEF34DE2, 0xF771768C, 0xCBFFD686, 0xC27DEDE8, 0xD8FBA05A, 0xD1799B34,
-    0x738AAD5C, 0x7A089632, 0x608EDB80, 0x690CE0EE, 0x558240E4, 0x5C007B8A, 0x46863638, 0x4F040D56,
-    0x3F9B762C, 0x36194D42, 0x2C9F00F0, 0x251D3B9E, 0x19939B94, 0x1011A0FA, 0x0A97ED48, 0x0315D626,
-    0xEBA91BBC, 0xE22B20D2, 0xF8AD6D60, 0xF12F560E, 0xCDA1F604, 0xC423CD6A, 0xDEA580D8, 0xD727BBB6,
-    0xA7B8C0CC, 0xAE3AFBA2, 0xB4BCB610, 0xBD3E8D7E, 0x81B02D74, 0x8832161A, 0x92B45BA8, 0x9B3660C6,
-    0x4A4FFBF2, 0x43CDC09C, 0x594B8D2E, 0x50C9B640, 0x6C47164A, 0x65C52D24, 0x7F436096, 0x76C15BF8,
-    0x065E2082, 0x0FDC1BEC, 0x155A565E, 0x1CD86D30, 0x2056CD3A, 0x29D4F654, 0x3352BBE6, 0x3AD08088,
-    0xD26C4D12, 0xDBEE767C, 0xC1683BCE, 0xC8EA00A0, 0xF464A0AA, 0xFDE69BC4, 0xE760D676, 0xEEE2ED18,
-    0x9E7D9662, 0x97FFAD0C, 0x8D79E0BE, 0x84FBDBD0, 0xB8757BDA, 0xB1F740B4, 0xAB710D06, 0xA2F33668,
-    0xE7155AB8, 0xEE9761D6, 0xF4112C64, 0xFD93170A, 0xC11DB700, 0xC89F8C6E, 0xD219C1DC, 0xDB9BFAB2,
-    0xAB0481C8, 0xA286BAA6, 0xB800F714, 0xB182CC7A, 0x8D0C6C70, 0x848E571E, 0x9E081AAC, 0x978A21C2,
-    0x7F36EC58, 0x76B4D736, 0x6C329A84, 0x65B0A1EA, 0x593E01E0, 0x50BC3A8E, 0x4A3A773C, 0x43B84C52,
-    0x33273728, 0x3AA50C46, 0x202341F4, 0x29A17A9A, 0x152FDA90, 0x1CADE1FE, 0x062BAC4C, 0x0FA99722,
-    0xDED00C16, 0xD7523778, 0xCDD47ACA, 0xC45641A4, 0xF8D8E1AE, 0xF15ADAC0, 0xEBDC9772, 0xE25EAC1C,
-    0x92C1D766, 0x9B43EC08, 0x81C5A1BA, 0x88479AD4, 0xB4C93ADE, 0xBD4B01B0, 0xA7CD4C02, 0xAE4F776C,
-    0x46F3BAF6, 0x4F718198, 0x55F7CC2A, 0x5C75F744, 0x60FB574E, 0x69796C20, 0x73FF2192, 0x7A7D1AFC,
-    0x0AE26186, 0x03605AE8, 0x19E6175A, 0x10642C34, 0x2CEA8C3E, 0x2568B750, 0x3FEEFAE2, 0x366CC18C,
-    0x949FF7E4, 0x9D1DCC8A, 0x879B8138, 0x8E19BA56, 0xB2971A5C, 0xBB152132, 0xA1936C80, 0xA81157EE,
-    0xD88E2C94, 0xD10C17FA, 0xCB8A5A48, 0xC2086126, 0xFE86C12C, 0xF704FA42, 0xED82B7F0, 0xE4008C9E,
-    0x0CBC4104, 0x053E7A6A, 0x1FB837D8, 0x163A0CB6, 0x2AB4ACBC, 0x233697D2, 0x39B0DA60, 0x3032E10E,
-    0x40AD9A74, 0x492FA11A, 0x53A9ECA8, 0x5A2BD7C6, 0x66A577CC, 0x6F274CA2, 0x75A10110, 0x7C233A7E,
-    0xAD5AA14A, 0xA4D89A24, 0xBE5ED796, 0xB7DCECF8, 0x8B524CF2, 0x82D0779C, 0x98563A2E, 0x91D40140,
-    0xE14B7A3A, 0xE8C94154, 0xF24F0CE6, 0xFBCD3788, 0xC7439782, 0xCEC1ACEC, 0xD447E15E, 0xDDC5DA30,
-    0x357917AA, 0x3CFB2CC4, 0x267D6176, 0x2FFF5A18, 0x1371FA12, 0x1AF3C17C, 0x00758CCE, 0x09F7B7A0,
-    0x7968CCDA, 0x70EAF7B4, 0x6A6CBA06, 0x63EE8168, 0x5F602162, 0x56E21A0C, 0x4C6457BE, 0x45E66CD0
-};
+// CRC32 lookup table, generated at compile time (see SLIPStream/Crc.hpp)
+static constexpr const std::array<uint32_t, 256>& crc32_table = Crc32::table;
+
+// Guard against accidental changes of the CRC parameters (matching Python implementation)
+static_assert(crc32_table[1] == 0x09823B6E && crc32_table[128] == 0xE7155AB8 && crc32_table[255] == 0x45E66CD0,
+              "CRC32 table does not match the SLIPStream CRC32");
 
 uint32_t calculate_crc32(const uint8_t* data, size_t length) {
     return calculate_crc32_with_initial(data, length, 0xFFFFFFFF);
 }
 
-uint32_t calculate_crc32_with_initial(const uint8_t* data, size_t length, uint32_t initial_crc) {
-    uint32_t crc = initial_crc;
-    
+namespace {
+
+/**
+ * Load 4 bytes in big-endian order, matching the MSB-first CRC
+ */
+inline uint32_t load_be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+/**
+ * Load 4 bytes in little-endian order, matching the LSB-first CRC-32C
+ */
+inline uint32_t load_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// CRC-32C polynomial in the LSB-first (reflected) register order
+constexpr uint32_t CRC32C_REFLECTED_POLYNOMIAL = static_cast<uint32_t>(detail::crc_reflect(Crc32C::polynomial, 32));
+
+/**
+ * No table: 8 shift & XOR steps per byte
+ */
+inline uint32_t crc32_bitwise_byte(uint32_t crc, uint8_t byte) {
+    crc ^= static_cast<uint32_t>(byte) << 24;
+    for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x80000000u) ? ((crc << 1) ^ detail::CRC32_TABLE_POLYNOMIAL) : (crc << 1);
+    }
+    return crc;
+}
+
+inline uint32_t crc32c_bitwise_byte(uint32_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? ((crc >> 1) ^ CRC32C_REFLECTED_POLYNOMIAL) : (crc >> 1);
+    }
+    return crc;
+}
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_NIBBLE
+using CrcNibbleTable = std::array<uint32_t, 16>;
+
+/**
+ * Tables for processing 4 bits at a time: The CRC register after processing
+ * the nibble i, starting from zero (MSB-first for CRC32, LSB-first for CRC-32C)
+ */
+constexpr CrcNibbleTable make_crc32_nibble_table() {
+    CrcNibbleTable table{};
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t crc = i << 28;
+        for (int bit = 0; bit < 4; bit++) {
+            crc = (crc & 0x80000000u) ? ((crc << 1) ^ detail::CRC32_TABLE_POLYNOMIAL) : (crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr CrcNibbleTable make_crc32c_nibble_table() {
+    CrcNibbleTable table{};
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 4; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ CRC32C_REFLECTED_POLYNOMIAL) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr CrcNibbleTable crc32_nibble_table = make_crc32_nibble_table();
+constexpr CrcNibbleTable crc32c_nibble_table = make_crc32c_nibble_table();
+
+inline uint32_t crc32_nibble_byte(uint32_t crc, uint8_t byte) {
+    crc = (crc << 4) ^ crc32_nibble_table[(crc >> 28) ^ (byte >> 4)];
+    return (crc << 4) ^ crc32_nibble_table[(crc >> 28) ^ (byte & 0x0F)];
+}
+
+inline uint32_t crc32c_nibble_byte(uint32_t crc, uint8_t byte) {
+    crc = (crc >> 4) ^ crc32c_nibble_table[(crc ^ byte) & 0x0F];
+    return (crc >> 4) ^ crc32c_nibble_table[(crc ^ (byte >> 4)) & 0x0F];
+}
+#endif
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+inline uint32_t crc32_table_byte(uint32_t crc, uint8_t byte) {
+    return (crc << 8) ^ crc32_table[((crc >> 24) ^ byte) & 0xFF];
+}
+#endif
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+using Crc32SliceTables = std::array<std::array<uint32_t, 256>, 16>;
+
+/**
+ * Generate the tables for slicing-by-8/16 from crc32_table:
+ * tables[k][b] is the CRC register after processing the byte b followed by
+ * k zero bytes, starting from zero. Since crc32_table is linear, the CRC of
+ * several bytes is the XOR of the table entries for the individual bytes.
+ */
+constexpr Crc32SliceTables make_crc32_slice_tables() {
+    Crc32SliceTables tables{};
+    for (size_t b = 0; b < 256; b++) {
+        tables[0][b] = crc32_table[b];
+    }
+    for (size_t k = 1; k < tables.size(); k++) {
+        for (size_t b = 0; b < 256; b++) {
+            uint32_t crc = tables[k - 1][b];
+            tables[k][b] = (crc << 8) ^ crc32_table[crc >> 24];
+        }
+    }
+    return tables;
+}
+
+constexpr Crc32SliceTables crc32_slice_tables = make_crc32_slice_tables();
+
+// Minimum lengths for slicing-by-8 and slicing-by-16. Below these, the setup cost
+// and the cache footprint of the larger tables outweigh the fewer iterations.
+constexpr size_t CRC32_SLICE8_THRESHOLD = 16;
+constexpr size_t CRC32_SLICE16_THRESHOLD = 256;
+
+inline uint32_t crc32_slice8_step(uint32_t crc, const uint8_t* p) {
+    const Crc32SliceTables& t = crc32_slice_tables;
+    uint32_t a = crc ^ load_be32(p);
+    uint32_t b = load_be32(p + 4);
+    return t[7][a >> 24] ^ t[6][(a >> 16) & 0xFF] ^ t[5][(a >> 8) & 0xFF] ^ t[4][a & 0xFF] ^
+           t[3][b >> 24] ^ t[2][(b >> 16) & 0xFF] ^ t[1][(b >> 8) & 0xFF] ^ t[0][b & 0xFF];
+}
+
+uint32_t crc32_update_slice8(uint32_t crc, const uint8_t* data, size_t length) {
+    while (length >= 8) {
+        crc = crc32_slice8_step(crc, data);
+        data += 8;
+        length -= 8;
+    }
+    return detail::crc32_update_bytewise(crc, data, length);
+}
+
+uint32_t crc32_update_slice16(uint32_t crc, const uint8_t* data, size_t length) {
+    const Crc32SliceTables& t = crc32_slice_tables;
+    while (length >= 16) {
+        uint32_t a = crc ^ load_be32(data);
+        uint32_t b = load_be32(data + 4);
+        uint32_t c = load_be32(data + 8);
+        uint32_t d = load_be32(data + 12);
+        crc = t[15][a >> 24] ^ t[14][(a >> 16) & 0xFF] ^ t[13][(a >> 8) & 0xFF] ^ t[12][a & 0xFF] ^
+              t[11][b >> 24] ^ t[10][(b >> 16) & 0xFF] ^ t[9][(b >> 8) & 0xFF] ^ t[8][b & 0xFF] ^
+              t[7][c >> 24] ^ t[6][(c >> 16) & 0xFF] ^ t[5][(c >> 8) & 0xFF] ^ t[4][c & 0xFF] ^
+              t[3][d >> 24] ^ t[2][(d >> 16) & 0xFF] ^ t[1][(d >> 8) & 0xFF] ^ t[0][d & 0xFF];
+        data += 16;
+        length -= 16;
+    }
+    return crc32_update_slice8(crc, data, length);
+}
+
+// CRC-32C slicing-by-8 tables, generated like crc32_slice_tables but LSB-first (reflected)
+using Crc32cSliceTables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Crc32cSliceTables make_crc32c_slice_tables() {
+    Crc32cSliceTables tables{};
+    for (size_t b = 0; b < 256; b++) {
+        tables[0][b] = Crc32C::table[b];
+    }
+    for (size_t k = 1; k < tables.size(); k++) {
+        for (size_t b = 0; b < 256; b++) {
+            uint32_t crc = tables[k - 1][b];
+            tables[k][b] = (crc >> 8) ^ Crc32C::table[crc & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr Crc32cSliceTables crc32c_slice_tables = make_crc32c_slice_tables();
+#endif
+
+/**
+ * One byte using the table size selected at compile time
+ */
+inline uint32_t crc32_update_byte(uint32_t crc, uint8_t byte) {
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+    return crc32_table_byte(crc, byte);
+#elif SLIPSTREAM_CRC32_LEVEL == SLIPSTREAM_CRC32_LEVEL_NIBBLE
+    return crc32_nibble_byte(crc, byte);
+#else
+    return crc32_bitwise_byte(crc, byte);
+#endif
+}
+
+inline uint32_t crc32c_update_byte(uint32_t crc, uint8_t byte) {
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+    return Crc32C::update(crc, &byte, 1);
+#elif SLIPSTREAM_CRC32_LEVEL == SLIPSTREAM_CRC32_LEVEL_NIBBLE
+    return crc32c_nibble_byte(crc, byte);
+#else
+    return crc32c_bitwise_byte(crc, byte);
+#endif
+}
+
+} // namespace
+
+namespace detail {
+
+uint32_t crc32_update_bitwise(uint32_t crc, const uint8_t* data, size_t length) {
     for (size_t i = 0; i < length; i++) {
-        uint8_t byte = data[i];
-        crc = ((crc << 8) ^ crc32_table[((crc >> 24) ^ byte) & 0xFF]) & 0xFFFFFFFF;
+        crc = crc32_bitwise_byte(crc, data[i]);
+    }
+    return crc;
+}
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_NIBBLE
+uint32_t crc32_update_nibble(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32_nibble_byte(crc, data[i]);
+    }
+    return crc;
+}
+#endif
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+uint32_t crc32_update_bytewise(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32_table_byte(crc, data[i]);
+    }
+    return crc;
+}
+#endif
+
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+uint32_t crc32_update_slicing(uint32_t crc, const uint8_t* data, size_t length) {
+    if (length >= CRC32_SLICE16_THRESHOLD) {
+        return crc32_update_slice16(crc, data, length);
+    }
+    if (length >= CRC32_SLICE8_THRESHOLD) {
+        return crc32_update_slice8(crc, data, length);
+    }
+    return crc32_update_bytewise(crc, data, length);
+}
+#endif
+
+uint32_t crc32_update_table(uint32_t crc, const uint8_t* data, size_t length) {
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+    return crc32_update_slicing(crc, data, length);
+#else
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32_update_byte(crc, data[i]);
+    }
+    return crc;
+#endif
+}
+
+void crc32_update_table_x4(uint32_t* crcs, const uint8_t* const* bufs, size_t length) {
+    // Four independent chains, which the CPU can execute in parallel
+    uint32_t c[4] = {crcs[0], crcs[1], crcs[2], crcs[3]};
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+    for (size_t pos = 0; pos < length; pos += 8) {
+        for (size_t i = 0; i < 4; i++) {
+            c[i] = crc32_slice8_step(c[i], bufs[i] + pos);
+        }
+    }
+#else
+    for (size_t pos = 0; pos < length; pos++) {
+        for (size_t i = 0; i < 4; i++) {
+            c[i] = crc32_update_byte(c[i], bufs[i][pos]);
+        }
+    }
+#endif
+    for (size_t i = 0; i < 4; i++) {
+        crcs[i] = c[i];
+    }
+}
+
+uint32_t crc32c_update_table(uint32_t crc, const uint8_t* data, size_t length) {
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+    const Crc32cSliceTables& t = crc32c_slice_tables;
+    while (length >= 8) {
+        uint32_t a = crc ^ load_le32(data);
+        uint32_t b = load_le32(data + 4);
+        crc = t[7][a & 0xFF] ^ t[6][(a >> 8) & 0xFF] ^ t[5][(a >> 16) & 0xFF] ^ t[4][a >> 24] ^
+              t[3][b & 0xFF] ^ t[2][(b >> 8) & 0xFF] ^ t[1][(b >> 16) & 0xFF] ^ t[0][b >> 24];
+        data += 8;
+        length -= 8;
+    }
+#endif
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32c_update_byte(crc, data[i]);
+    }
+    return crc;
+}
+
+} // namespace detail
+
+uint32_t calculate_crc32_with_initial(const uint8_t* data, size_t length, uint32_t initial_crc) {
+    return detail::kernels().crc32_update(initial_crc, data, length);
+}
+
+namespace {
+
+/**
+ * a(x) * b(x) mod G(x), see CRC32_TABLE_POLYNOMIAL
+ */
+uint32_t crc32_multiply(uint32_t a, uint32_t b) {
+    uint32_t product = 0;
+    for (int bit = 31; bit >= 0; bit--) {
+        // product = product * x mod G
+        product = (product & 0x80000000u) ? ((product << 1) ^ detail::CRC32_TABLE_POLYNOMIAL) : (product << 1);
+        if (b & (1u << bit)) {
+            product ^= a;
+        }
+    }
+    return product;
+}
+
+/**
+ * x^(8 * n) mod G(x), i.e. the effect of n zero bytes on the CRC register
+ */
+uint32_t crc32_xpow8n(size_t n) {
+    uint32_t result = 1; // x^0
+    uint32_t power = 0x100; // x^8
+    while (n != 0) {
+        if (n & 1) {
+            result = crc32_multiply(result, power);
+        }
+        power = crc32_multiply(power, power);
+        n >>= 1;
+    }
+    return result;
+}
+
+// Minimum number of bytes per thread for calculate_crc32_parallel()
+constexpr size_t CRC32_PARALLEL_MIN_CHUNK = 1 << 20;
+
+} // namespace
+
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t length_b) {
+    // crc_b = shift(0xFFFFFFFF) ^ crc0(B) where shift() is the effect of length_b bytes
+    // on the CRC register and crc0(B) is the CRC of B with initial value 0.
+    // Continuing crc_a over B instead yields shift(crc_a) ^ crc0(B).
+    return crc32_multiply(crc_a ^ 0xFFFFFFFF, crc32_xpow8n(length_b)) ^ crc_b;
+}
+
+uint32_t calculate_crc32_parallel(const uint8_t* data, size_t length, unsigned max_threads) {
+#if defined(SLIPSTREAM_NO_THREADS)
+    (void)max_threads;
+    return calculate_crc32(data, length);
+#else
+    size_t threads = (max_threads != 0) ? max_threads : std::thread::hardware_concurrency();
+    // Every thread needs enough data to make up for starting it
+    threads = std::min(threads, length / CRC32_PARALLEL_MIN_CHUNK);
+    if (threads <= 1) {
+        return calculate_crc32(data, length);
+    }
+    size_t chunk = length / threads;
+    auto chunk_size = [=](size_t i) {
+        return (i == threads - 1) ? length - i * chunk : chunk; // Last chunk takes the rest
+    };
+    std::vector<uint32_t> crcs(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t started = 1;
+#if defined(SLIPSTREAM_EXCEPTIONS)
+    try {
+#endif
+        for (; started < threads; started++) {
+            const uint8_t* begin = data + started * chunk;
+            size_t size = chunk_size(started);
+            uint32_t* result = &crcs[started];
+            workers.emplace_back([result, begin, size]() {
+                *result = calculate_crc32(begin, size);
+            });
+        }
+#if defined(SLIPSTREAM_EXCEPTIONS)
+    } catch (const std::system_error&) {
+        // No more threads available: The calling thread processes the remaining chunks
+    }
+#endif
+    // The calling thread processes the first chunk
+    crcs[0] = calculate_crc32(data, chunk);
+    for (size_t i = started; i < threads; i++) {
+        crcs[i] = calculate_crc32(data + i * chunk, chunk_size(i));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    uint32_t crc = crcs[0];
+    for (size_t i = 1; i < threads; i++) {
+        crc = crc32_combine(crc, crcs[i], chunk_size(i));
     }
-    
     return crc;
+#endif
+}
+
+namespace {
+
+// Number of buffers processed in lockstep by calculate_crc32_batch()
+constexpr size_t CRC32_BATCH_LANES = 4;
+
+} // namespace
+
+void calculate_crc32_batch(const uint8_t* const* bufs, const size_t* lens, uint32_t* out, size_t n) {
+    const detail::KernelTable& k = detail::kernels();
+    size_t i = 0;
+    for (; i + CRC32_BATCH_LANES <= n; i += CRC32_BATCH_LANES) {
+        const uint8_t* const* b = bufs + i;
+        const size_t* l = lens + i;
+        // The common length is processed in lockstep, the remainder of each buffer individually
+        size_t common = std::min(std::min(l[0], l[1]), std::min(l[2], l[3])) & ~static_cast<size_t>(15);
+        uint32_t* crcs = out + i;
+        crcs[0] = crcs[1] = crcs[2] = crcs[3] = 0xFFFFFFFF;
+        k.crc32_update_x4(crcs, b, common);
+        for (size_t lane = 0; lane < CRC32_BATCH_LANES; lane++) {
+            crcs[lane] = k.crc32_update(crcs[lane], b[lane] + common, l[lane] - common);
+        }
+    }
+    for (; i < n; i++) {
+        out[i] = k.crc32_update(0xFFFFFFFF, bufs[i], lens[i]);
+    }
 }
 
 size_t append_crc32(uint8_t* data, size_t length) {
@@ -113,4 +505,49 @@ bool verify_crc32(const uint8_t* data, size_t length) {
     return calculated_crc == stored_crc;
 }
 
+uint32_t calculate_crc32c(const uint8_t* data, size_t length) {
+    return calculate_crc32c_with_initial(data, length, 0);
+}
+
+uint32_t calculate_crc32c_with_initial(const uint8_t* data, size_t length, uint32_t initial_crc) {
+    // The register is inverted before and after, so a previous result continues the CRC
+    return ~detail::kernels().crc32c_update(~initial_crc, data, length);
+}
+
+size_t append_crc32c(uint8_t* data, size_t length) {
+    if (data == nullptr) {
+        return length;
+    }
+    
+    uint32_t crc = calculate_crc32c(data, length);
+    
+    // Append CRC in little-endian format (LSB first)
+    data[length] = crc & 0xFF;
+    data[length + 1] = (crc >> 8) & 0xFF;
+    data[length + 2] = (crc >> 16) & 0xFF;
+    data[length + 3] = (crc >> 24) & 0xFF;
+    
+    return length + 4;
+}
+
+size_t extract_crc32c(const uint8_t* data, size_t length, uint32_t* crc_out) {
+    // Same trailer format as CRC32
+    return extract_crc32(data, length, crc_out);
+}
+
+bool verify_crc32c(const uint8_t* data, size_t length) {
+    if (data == nullptr || length < 4) {
+        return false;
+    }
+    
+    uint32_t stored_crc;
+    size_t data_length = extract_crc32c(data, length, &stored_crc);
+    
+    if (data_length == 0) {
+        return false;
+    }
+    
+    return calculate_crc32c(data, data_length) == stored_crc;
+}
+
 } // namespace SLIPStream
@@ -1,15 +1,18 @@
 #include "SLIPStream/SLIP.hpp"
 #include "SLIPStream/Decoder.hpp"
 #include "SLIPStream/Error.hpp"
+#include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
+#include <cstring>
 
 namespace SLIPStream {
 
 Decoder::Decoder(uint8_t* rxbuf, size_t rxbufSize, std::function<void(uint8_t*, size_t)> messageCallback, std::function<void(LogType, const char*)> logCallback)
-    : lastCharIsEsc(false), rxbuf(rxbuf), rxbufPos(0), rxbufSize(rxbufSize), messageCallback(messageCallback), logCallback(logCallback), logCallbackEx(nullptr), lastError(ErrorCode::Success), consumedCount(0) {
+    : lastCharIsEsc(false), rxbuf(rxbuf), rxbufPos(0), rxbufSize(rxbufSize), messageCallback(messageCallback), logCallback(logCallback), logCallbackEx(nullptr), lastError(ErrorCode::Success), consumedCount(0), checkCrc32(false), rxCrc() {
 }
 
 Decoder::Decoder(uint8_t* rxbuf, size_t rxbufSize, std::function<void(uint8_t*, size_t)> messageCallback, std::function<void(LogInfo)> logCallbackEx)
-    : lastCharIsEsc(false), rxbuf(rxbuf), rxbufPos(0), rxbufSize(rxbufSize), messageCallback(messageCallback), logCallback(nullptr), logCallbackEx(logCallbackEx), lastError(ErrorCode::Success), consumedCount(0) {
+    : lastCharIsEsc(false), rxbuf(rxbuf), rxbufPos(0), rxbufSize(rxbufSize), messageCallback(messageCallback), logCallback(nullptr), logCallbackEx(logCallbackEx), lastError(ErrorCode::Success), consumedCount(0), checkCrc32(false), rxCrc() {
 }
 
 
@@ -53,34 +56,39 @@ void Decoder::consume(uint8_t c) {
             logCallbackEx(LogInfo(ErrorCode::RXBufferOverflow, consumedCount, "RX buffer overflow"));
         }
         lastError = ErrorInfo(ErrorCode::RXBufferOverflow, consumedCount, "RX buffer overflow");
-		reset();
+		resetFrame();
     }
     // Adapted from https://techoverflow.net/2022/07/19/a-python-slip-decoder-using-serial_asyncio/
     if(lastCharIsEsc) {
         // This character must be either
         // SLIP_ESCEND or SLIP_ESCESC
         if(c == ESCEND) { // Literal END character
-            rxbuf[rxbufPos++] = END;
+            storeByte(END);
         } else if(c == ESCESC) { // Literal ESC character
-            rxbuf[rxbufPos++] = ESC;
+            storeByte(ESC);
         } else {
             //print(red("Encountered invalid SLIP escape sequence. Ignoring..."))
             // Ignore bad part of message
-            lastError = ErrorInfo(ErrorCode::DecodeInvalidEscapeSequence, consumedCount, "Invalid escape sequence");
-            reset();
+            size_t pos = consumedCount;
+            resetFrame();
+            reportInvalidEscape(pos);
         }
         lastCharIsEsc = false; // Reset state
     } else { // last char was NOT ESC
         if(c == END) { // END of message
             // Emit message
-            messageCallback(rxbuf, rxbufPos);
+            size_t pos = consumedCount;
+            bool valid = emitFrame(rxbuf, rxbufPos, rxCrc.value(), pos);
             // Remove current message from buffer
-            reset();
+            resetFrame();
+            if (!valid) {
+                lastError = ErrorInfo(ErrorCode::DecodeCrcMismatch, pos, "CRC32 mismatch");
+            }
         } else if(c == ESC) {
             // Handle escaped character next 
             lastCharIsEsc = true;
         } else { // Any other character
-            rxbuf[rxbufPos++] = c;
+            storeByte(c);
         }
     }
     consumedCount++;
@@ -95,7 +103,7 @@ Decoder::ConsumeResult Decoder::consume_ex(uint8_t c) {
             logCallbackEx(LogInfo(ErrorCode::RXBufferOverflow, consumedCount, "RX buffer overflow"));
         }
         lastError = ErrorInfo(ErrorCode::RXBufferOverflow, consumedCount, "RX buffer overflow");
-        reset();
+        resetFrame();
         return ConsumeResult(ErrorCode::RXBufferOverflow, 1, consumedCount, "RX buffer overflow");
     }
     // Adapted from https://techoverflow.net/2022/07/19/a-python-slip-decoder-using-serial_asyncio/
@@ -103,28 +111,34 @@ Decoder::ConsumeResult Decoder::consume_ex(uint8_t c) {
         // This character must be either
         // SLIP_ESCEND or SLIP_ESCESC
         if(c == ESCEND) { // Literal END character
-            rxbuf[rxbufPos++] = END;
+            storeByte(END);
         } else if(c == ESCESC) { // Literal ESC character
-            rxbuf[rxbufPos++] = ESC;
+            storeByte(ESC);
         } else {
             //print(red("Encountered invalid SLIP escape sequence. Ignoring..."))
             // Ignore bad part of message
-            lastError = ErrorInfo(ErrorCode::DecodeInvalidEscapeSequence, consumedCount, "Invalid escape sequence");
-            reset();
-            return ConsumeResult(ErrorCode::DecodeInvalidEscapeSequence, 1, consumedCount, "Invalid escape sequence");
+            size_t pos = consumedCount;
+            resetFrame();
+            reportInvalidEscape(pos);
+            return ConsumeResult(ErrorCode::DecodeInvalidEscapeSequence, 1, pos, "Invalid escape sequence");
         }
         lastCharIsEsc = false; // Reset state
     } else { // last char was NOT ESC
         if(c == END) { // END of message
             // Emit message
-            messageCallback(rxbuf, rxbufPos);
+            size_t pos = consumedCount;
+            bool valid = emitFrame(rxbuf, rxbufPos, rxCrc.value(), pos);
             // Remove current message from buffer
-            reset();
+            resetFrame();
+            if (!valid) {
+                lastError = ErrorInfo(ErrorCode::DecodeCrcMismatch, pos, "CRC32 mismatch");
+                return ConsumeResult(ErrorCode::DecodeCrcMismatch, 1, pos, "CRC32 mismatch");
+            }
         } else if(c == ESC) {
             // Handle escaped character next 
             lastCharIsEsc = true;
         } else { // Any other character
-            rxbuf[rxbufPos++] = c;
+            storeByte(c);
         }
     }
     consumedCount++;
@@ -144,10 +158,92 @@ Decoder::ConsumeResult Decoder::consume_chunk_ex(const uint8_t* data, size_t siz
     return ConsumeResult(consumed);
 }
 
+void Decoder::consume_inplace(uint8_t* data, size_t size) {
+    size_t pos = 0;
+    // Finish the frame which has been started in a previous call using the RX buffer
+    while (pos < size && (rxbufPos > 0 || lastCharIsEsc)) {
+        consume(data[pos++]);
+    }
+    while (pos < size) {
+        // Only decode complete frames in place, so an incomplete frame is not modified
+        const uint8_t* frameEnd = static_cast<const uint8_t*>(memchr(data + pos, END, size - pos));
+        if (frameEnd == nullptr) {
+            consume(data + pos, size - pos);
+            return;
+        }
+        size_t frameSize = static_cast<size_t>(frameEnd - data) + 1 - pos; // Including END
+        Result<size_t> result = decode_packet_inplace_ex(data + pos, frameSize);
+        if (result.is_success()) {
+            // The decoded frame is still in the cache, so compute its CRC in one go
+            uint32_t crc = (checkCrc32 && result.value >= 4) ? calculate_crc32(data + pos, result.value - 4) : 0;
+            if (!emitFrame(data + pos, result.value, crc, pos)) {
+                lastError = ErrorInfo(ErrorCode::DecodeCrcMismatch, pos, "CRC32 mismatch");
+            }
+        } else {
+            // Invalid escape sequence: Like consume(), drop the bytes before it and the
+            // invalid escape sequence itself, then continue with the byte after it.
+            // The decoded bytes are at [data + pos], so the ESC is at:
+            size_t escPos = pos + encoded_length(data + pos, result.error.position) - 1;
+            reportInvalidEscape(escPos);
+            pos = escPos + 2;
+            continue;
+        }
+        pos += frameSize;
+    }
+}
+
+void Decoder::storeByte(uint8_t b) {
+    rxbuf[rxbufPos++] = b;
+    // The last 4 bytes might be the CRC trailer, so the CRC lags 4 bytes behind
+    if (checkCrc32 && rxbufPos > 4) {
+        rxCrc.update(rxbuf[rxbufPos - 5]);
+    }
+}
+
+bool Decoder::emitFrame(uint8_t* frame, size_t size, uint32_t crc, size_t pos) {
+    if (!checkCrc32) {
+        messageCallback(frame, size);
+        return true;
+    }
+    if (size == 0) {
+        return true; // Empty frame, e.g. a leading END
+    }
+    uint32_t storedCrc = 0;
+    if (size >= 4) {
+        extract_crc32(frame, size, &storedCrc);
+    }
+    if (size < 4 || storedCrc != crc) {
+        if (logCallback) {
+            logCallback(LogType::CrcMismatch, "CRC32 mismatch");
+        }
+        if (logCallbackEx) {
+            logCallbackEx(LogInfo(ErrorCode::DecodeCrcMismatch, pos, "CRC32 mismatch"));
+        }
+        return false;
+    }
+    messageCallback(frame, size - 4);
+    return true;
+}
+
+void Decoder::reportInvalidEscape(size_t pos) {
+    if (logCallback) {
+        logCallback(LogType::InvalidEscapeSequence, "Invalid escape sequence");
+    }
+    if (logCallbackEx) {
+        logCallbackEx(LogInfo(ErrorCode::DecodeInvalidEscapeSequence, pos, "Invalid escape sequence"));
+    }
+    lastError = ErrorInfo(ErrorCode::DecodeInvalidEscapeSequence, pos, "Invalid escape sequence");
+}
+
 void Decoder::reset() {
+    resetFrame();
+    lastError = ErrorInfo(ErrorCode::Success);
+}
+
+void Decoder::resetFrame() {
     rxbufPos = 0;
+    rxCrc.reset();
 	lastCharIsEsc = false;
-    lastError = ErrorInfo(ErrorCode::Success);
     consumedCount = 0;
 }
 
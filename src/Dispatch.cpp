@@ -0,0 +1,223 @@
+/**
+ * @file Dispatch.cpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * CPU feature detection and runtime kernel selection.
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#include "SLIPStream/Dispatch.hpp"
+#include "SLIPStream/BasicEncoder.hpp"
+#include "Kernels.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(SLIPSTREAM_X86_64) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace SLIPStream {
+
+namespace {
+
+struct CpuFeatures {
+    bool sse42 = false;
+    bool popcnt = false;
+    bool pclmul = false;
+    bool avx2 = false;
+};
+
+CpuFeatures detect_cpu_features() {
+    CpuFeatures features;
+#if defined(SLIPSTREAM_X86_64)
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    unsigned max_leaf = static_cast<unsigned>(regs[0]);
+    __cpuid(regs, 1);
+    ecx = static_cast<unsigned>(regs[2]);
+#else
+    unsigned max_leaf = __get_cpuid_max(0, nullptr);
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+#endif
+    features.sse42 = (ecx & (1u << 20)) != 0;
+    features.popcnt = (ecx & (1u << 23)) != 0;
+    features.pclmul = (ecx & (1u << 1)) != 0;
+    // AVX requires OS support for saving the YMM registers (OSXSAVE + XCR0 bits 1 & 2)
+    bool osxsave = (ecx & (1u << 27)) != 0;
+    bool avx = (ecx & (1u << 28)) != 0;
+    bool os_ymm = false;
+    if (osxsave && avx) {
+#if defined(_MSC_VER)
+        uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0_lo, xcr0_hi;
+        __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        uint64_t xcr0 = (static_cast<uint64_t>(xcr0_hi) << 32) | xcr0_lo;
+#endif
+        os_ymm = (xcr0 & 0x6) == 0x6;
+    }
+    if (os_ymm && max_leaf >= 7) {
+#if defined(_MSC_VER)
+        __cpuidex(regs, 7, 0);
+        ebx = static_cast<unsigned>(regs[1]);
+#else
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
+#endif
+        features.avx2 = (ebx & (1u << 5)) != 0;
+    }
+#endif
+    return features;
+}
+
+const CpuFeatures& cpu_features() {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+#if defined(SLIPSTREAM_X86_64)
+/**
+ * Copy of an x86-64 kernel table which does not use PCLMULQDQ, for CPUs which do not
+ * support it: CRC32 uses the portable lookup tables, CRC-32C a single stream of
+ * crc32 instructions instead of interleaved lanes combined by carry-less multiplication.
+ */
+detail::KernelTable without_pclmul(detail::KernelTable table) {
+    table.crc32_update = detail::crc32_update_table;
+    table.crc32_update_x4 = detail::crc32_update_table_x4;
+    table.crc32c_update = detail::crc32c_update_sse42_serial;
+    return table;
+}
+#endif
+
+const detail::KernelTable* table_for(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar: return &detail::scalar_kernels;
+        case Kernel::SWAR: return &detail::swar_kernels;
+#if defined(SLIPSTREAM_X86_64)
+        case Kernel::SSE42: {
+            if (cpu_features().pclmul) {
+                return &detail::sse42_kernels;
+            }
+            static const detail::KernelTable sse42_table_crc32 = without_pclmul(detail::sse42_kernels);
+            return &sse42_table_crc32;
+        }
+        case Kernel::AVX2: {
+            if (cpu_features().pclmul) {
+                return &detail::avx2_kernels;
+            }
+            static const detail::KernelTable avx2_table_crc32 = without_pclmul(detail::avx2_kernels);
+            return &avx2_table_crc32;
+        }
+#endif
+        default: return nullptr;
+    }
+}
+
+/**
+ * Parse the SLIPSTREAM_KERNEL environment variable.
+ * @return Kernel::Auto if it is not set or not recognized
+ */
+Kernel kernel_from_environment() {
+    const char* name = std::getenv("SLIPSTREAM_KERNEL");
+    if (name == nullptr) {
+        return Kernel::Auto;
+    }
+    for (Kernel kernel : {Kernel::Scalar, Kernel::SWAR, Kernel::SSE42, Kernel::AVX2}) {
+        if (strcmp(name, kernel_name(kernel)) == 0) {
+            return kernel;
+        }
+    }
+    return Kernel::Auto;
+}
+
+/**
+ * The active kernel table, or nullptr if it has not been selected yet.
+ * Concurrent first uses may both run the selection, but they select the same table.
+ */
+std::atomic<const detail::KernelTable*> active_table{nullptr};
+
+const detail::KernelTable* select_table(Kernel requested) {
+    if (requested == Kernel::Auto || !kernel_supported(requested)) {
+        requested = best_supported_kernel();
+    }
+    return table_for(requested);
+}
+
+} // namespace
+
+namespace detail {
+
+const KernelTable& kernels() {
+    const KernelTable* table = active_table.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        table = select_table(kernel_from_environment());
+        active_table.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+// Declared in BasicEncoder.hpp, which cannot include the internal kernel table
+const uint8_t* find_special(const uint8_t* in, const uint8_t* inend) {
+    return kernels().find_special(in, inend);
+}
+
+} // namespace detail
+
+Kernel active_kernel() {
+    return detail::kernels().kernel;
+}
+
+Kernel best_supported_kernel() {
+    if (kernel_supported(Kernel::AVX2)) {
+        return Kernel::AVX2;
+    }
+    if (kernel_supported(Kernel::SSE42)) {
+        return Kernel::SSE42;
+    }
+    return Kernel::SWAR;
+}
+
+bool kernel_supported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Auto:
+        case Kernel::Scalar:
+        case Kernel::SWAR:
+            return true;
+#if defined(SLIPSTREAM_X86_64)
+        case Kernel::SSE42:
+            // The CRC kernels use PCLMULQDQ only if it is available (see table_for())
+            return cpu_features().sse42 && cpu_features().popcnt;
+        case Kernel::AVX2:
+            // The AVX2 kernels use the SSE4.2 kernels for the remainder
+            return cpu_features().avx2 && kernel_supported(Kernel::SSE42);
+#endif
+        default:
+            return false;
+    }
+}
+
+bool force_kernel(Kernel kernel) {
+    if (!kernel_supported(kernel)) {
+        return false;
+    }
+    active_table.store(select_table(kernel), std::memory_order_release);
+    return true;
+}
+
+const char* kernel_name(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Auto: return "auto";
+        case Kernel::Scalar: return "scalar";
+        case Kernel::SWAR: return "swar";
+        case Kernel::SSE42: return "sse42";
+        case Kernel::AVX2: return "avx2";
+        default: return "unknown";
+    }
+}
+
+} // namespace SLIPStream
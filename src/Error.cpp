@@ -10,6 +10,8 @@ const char* error_code_to_string(ErrorCode code) {
             return "EncodeBufferTooSmall";
         case ErrorCode::EncodeInternalError:
             return "EncodeInternalError";
+        case ErrorCode::EncodeInvalidPacketState:
+            return "EncodeInvalidPacketState";
         case ErrorCode::DecodeBufferTooSmall:
             return "DecodeBufferTooSmall";
         case ErrorCode::DecodeNoEndMarker:
@@ -20,6 +22,8 @@ const char* error_code_to_string(ErrorCode code) {
             return "DecodeTruncatedEscape";
         case ErrorCode::DecodeInternalError:
             return "DecodeInternalError";
+        case ErrorCode::DecodeCrcMismatch:
+            return "DecodeCrcMismatch";
         case ErrorCode::RXBufferOverflow:
             return "RXBufferOverflow";
         case ErrorCode::UnknownError:
@@ -37,6 +41,8 @@ const char* get_error_message(ErrorCode code) {
             return "Output buffer is too small to hold encoded data";
         case ErrorCode::EncodeInternalError:
             return "Internal encoding error occurred";
+        case ErrorCode::EncodeInvalidPacketState:
+            return "Encoder call not allowed in the current packet state (e.g. append() without beginPacket())";
         case ErrorCode::DecodeBufferTooSmall:
             return "Output buffer is too small to hold decoded data";
         case ErrorCode::DecodeNoEndMarker:
@@ -47,6 +53,8 @@ const char* get_error_message(ErrorCode code) {
             return "Truncated escape sequence: ESC at end of input";
         case ErrorCode::DecodeInternalError:
             return "Internal decoding error occurred";
+        case ErrorCode::DecodeCrcMismatch:
+            return "CRC32 of the decoded frame does not match its CRC32 trailer";
         case ErrorCode::RXBufferOverflow:
             return "RX buffer overflow during decoding";
         case ErrorCode::UnknownError:
@@ -0,0 +1,185 @@
+/**
+ * @file Kernels.hpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * Internal: Byte-processing kernels and the runtime dispatch table.
+ * Not part of the public API, see SLIPStream/Dispatch.hpp instead.
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "SLIPStream/Crc.hpp"
+#include "SLIPStream/Dispatch.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// x86-64 kernels are compiled using function-level target attributes,
+// so they are available even if the library is built for generic x86-64.
+#if defined(__x86_64__) || defined(_M_X64)
+#define SLIPSTREAM_X86_64 1
+#endif
+
+#if defined(SLIPSTREAM_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define SLIPSTREAM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SLIPSTREAM_TARGET(isa)
+#endif
+
+/**
+ * Size of the portable CRC32 & CRC-32C lookup tables, selected at compile time by
+ * defining one of these macros (default: slicing):
+ * - SLIPSTREAM_CRC32_BITWISE: No table, 8 shift & XOR steps per byte
+ * - SLIPSTREAM_CRC32_NIBBLE:  16 entry tables (64 bytes each)
+ * - SLIPSTREAM_CRC32_BYTE:    256 entry tables (1 KiB each)
+ * - Slicing:                  256 entry and slicing-by-8/16 tables (17 KiB CRC32, 8 KiB CRC-32C)
+ * Only the variants up to the selected level are compiled.
+ */
+#define SLIPSTREAM_CRC32_LEVEL_BITWISE 0
+#define SLIPSTREAM_CRC32_LEVEL_NIBBLE 1
+#define SLIPSTREAM_CRC32_LEVEL_BYTE 2
+#define SLIPSTREAM_CRC32_LEVEL_SLICING 3
+#if (defined(SLIPSTREAM_CRC32_BITWISE) + defined(SLIPSTREAM_CRC32_NIBBLE) + defined(SLIPSTREAM_CRC32_BYTE)) > 1
+#error "Define at most one of SLIPSTREAM_CRC32_BITWISE, SLIPSTREAM_CRC32_NIBBLE and SLIPSTREAM_CRC32_BYTE"
+#elif defined(SLIPSTREAM_CRC32_BITWISE)
+#define SLIPSTREAM_CRC32_LEVEL SLIPSTREAM_CRC32_LEVEL_BITWISE
+#elif defined(SLIPSTREAM_CRC32_NIBBLE)
+#define SLIPSTREAM_CRC32_LEVEL SLIPSTREAM_CRC32_LEVEL_NIBBLE
+#elif defined(SLIPSTREAM_CRC32_BYTE)
+#define SLIPSTREAM_CRC32_LEVEL SLIPSTREAM_CRC32_LEVEL_BYTE
+#else
+#define SLIPSTREAM_CRC32_LEVEL SLIPSTREAM_CRC32_LEVEL_SLICING
+#endif
+
+namespace SLIPStream {
+namespace detail {
+
+/**
+ * Function pointers to one implementation of every kernel.
+ */
+struct KernelTable {
+    Kernel kernel;
+
+    /**
+     * Count the number of END and ESC bytes in [in, in + inlen)
+     */
+    size_t (*count_special)(const uint8_t* in, size_t inlen);
+
+    /**
+     * Find the first END or ESC byte in [in, inend)
+     * @return Pointer to the first special byte, or inend if there is none
+     */
+    const uint8_t* (*find_special)(const uint8_t* in, const uint8_t* inend);
+
+    /**
+     * Encode the bulk of [in, inend) into [out, outend) with only one bounds check
+     * per block. Stops when the remaining input or output space is too small for
+     * another block, leaving room for the trailing END. [in] and [out] are advanced
+     * past the data processed, the caller encodes the remainder with exact bounds
+     * checks (and error reporting).
+     */
+    void (*encode_bulk)(const uint8_t*& in, const uint8_t* inend, uint8_t*& out, const uint8_t* outend);
+
+    /**
+     * Decode the bulk of [in, inend) into [out, outend) with only one bounds check
+     * per block. Stops at the first END byte or invalid escape sequence ([in] pointing
+     * to it), or when the remaining input or output space is too small for another block.
+     * [in] and [out] are advanced past the data processed, the caller decodes the
+     * remainder with exact bounds checks (and error reporting).
+     */
+    void (*decode_bulk)(const uint8_t*& in, const uint8_t* inend, uint8_t*& out, const uint8_t* outend);
+
+    /**
+     * Update a CRC32 (see CRC32.hpp) with the given data
+     */
+    uint32_t (*crc32_update)(uint32_t crc, const uint8_t* data, size_t length);
+
+    /**
+     * Update four independent CRC32s, each with [length] bytes of its own buffer,
+     * interleaving the calculations. [length] must be a multiple of 16.
+     */
+    void (*crc32_update_x4)(uint32_t* crcs, const uint8_t* const* bufs, size_t length);
+
+    /**
+     * Update a CRC-32C register (reflected, without the final inversion) with the given data
+     */
+    uint32_t (*crc32c_update)(uint32_t crc, const uint8_t* data, size_t length);
+};
+
+/**
+ * @return The currently active kernel table (detected on first use)
+ */
+const KernelTable& kernels();
+
+// Implementations (KernelsGeneric.cpp)
+extern const KernelTable scalar_kernels;
+extern const KernelTable swar_kernels;
+#if defined(SLIPSTREAM_X86_64)
+// Implementations (KernelsSSE42.cpp, KernelsAVX2.cpp)
+extern const KernelTable sse42_kernels;
+extern const KernelTable avx2_kernels;
+#endif
+
+// Portable table-driven CRC32 (CRC32.cpp), using the variant selected by SLIPSTREAM_CRC32_LEVEL
+uint32_t crc32_update_table(uint32_t crc, const uint8_t* data, size_t length);
+
+// The portable CRC32 variants up to the selected level (CRC32.cpp), for benchmarks & tests
+uint32_t crc32_update_bitwise(uint32_t crc, const uint8_t* data, size_t length);
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_NIBBLE
+uint32_t crc32_update_nibble(uint32_t crc, const uint8_t* data, size_t length);
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+uint32_t crc32_update_bytewise(uint32_t crc, const uint8_t* data, size_t length);
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+uint32_t crc32_update_slicing(uint32_t crc, const uint8_t* data, size_t length);
+#endif
+
+// Lookup table memory of the CRC32 variants (each CRC-32C fallback needs the same
+// amount, except for slicing, which uses slicing-by-8 (8 KiB) for CRC-32C)
+constexpr size_t CRC32_NIBBLE_TABLE_BYTES = 16 * sizeof(uint32_t);
+constexpr size_t CRC32_BYTE_TABLE_BYTES = 256 * sizeof(uint32_t);
+constexpr size_t CRC32_SLICING_TABLE_BYTES = CRC32_BYTE_TABLE_BYTES + 16 * 256 * sizeof(uint32_t);
+void crc32_update_table_x4(uint32_t* crcs, const uint8_t* const* bufs, size_t length);
+
+/**
+ * The CRC32 lookup table (SLIPStream::Crc32::table) implements the MSB-first CRC with the
+ * generator polynomial G(x) = x^32 + CRC32_TABLE_POLYNOMIAL, i.e. the Ethernet
+ * polynomial 0x04C11DB7 shifted left by one bit. Kernels computing the CRC
+ * by other means must use this polynomial to give identical results.
+ */
+constexpr uint32_t CRC32_TABLE_POLYNOMIAL = Crc32::polynomial;
+
+// Portable table-driven CRC-32C (CRC32.cpp), using slicing-by-8 for longer data
+uint32_t crc32c_update_table(uint32_t crc, const uint8_t* data, size_t length);
+
+#if defined(SLIPSTREAM_X86_64)
+// Carry-less multiplication (PCLMULQDQ) CRC32 (KernelsSSE42.cpp)
+uint32_t crc32_update_pclmul(uint32_t crc, const uint8_t* data, size_t length);
+void crc32_update_pclmul_x4(uint32_t* crcs, const uint8_t* const* bufs, size_t length);
+// CRC-32C using the SSE4.2 crc32 instruction (KernelsSSE42.cpp): Three interleaved
+// lanes combined using PCLMULQDQ, or a single stream for CPUs without PCLMULQDQ
+uint32_t crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t length);
+uint32_t crc32c_update_sse42_serial(uint32_t crc, const uint8_t* data, size_t length);
+#endif
+
+/**
+ * Index of the lowest set bit in a non-zero mask
+ */
+inline unsigned lowest_set_bit(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+} // namespace detail
+} // namespace SLIPStream
@@ -0,0 +1,192 @@
+/**
+ * @file KernelsAVX2.cpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * x86-64 kernels processing 32 bytes per iteration (AVX2).
+ * Compiled using function-level target attributes and only called
+ * after the CPU has been checked for support (see Dispatch.cpp).
+ * The remainder which is too short for a full AVX2 block is
+ * processed using the SSE4.2 kernels.
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#include "Kernels.hpp"
+
+#if defined(SLIPSTREAM_X86_64)
+#include "SLIPStream/SLIP.hpp"
+#include <immintrin.h>
+
+namespace SLIPStream {
+namespace detail {
+
+namespace {
+
+/**
+ * @return Bitmask of the END and ESC bytes in [v]
+ */
+SLIPSTREAM_TARGET("avx2")
+inline uint32_t special_mask(__m256i v) {
+    const __m256i vend = _mm256_set1_epi8(static_cast<char>(END));
+    const __m256i vesc = _mm256_set1_epi8(static_cast<char>(ESC));
+    __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, vend), _mm256_cmpeq_epi8(v, vesc));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+}
+
+SLIPSTREAM_TARGET("avx2")
+inline __m256i load(const uint8_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+SLIPSTREAM_TARGET("avx2")
+inline void store(uint8_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+SLIPSTREAM_TARGET("avx2")
+size_t avx2_count_special(const uint8_t* in, size_t inlen) {
+    size_t count = 0;
+    const uint8_t* inend = in + inlen;
+    const __m256i vend = _mm256_set1_epi8(static_cast<char>(END));
+    const __m256i vesc = _mm256_set1_epi8(static_cast<char>(ESC));
+    while (inend - in >= 32) {
+        // Per-byte counters are 8 bits wide, so fold them into
+        // the 64-bit total at least every 255 iterations.
+        size_t blocks = static_cast<size_t>(inend - in) / 32;
+        if (blocks > 255) {
+            blocks = 255;
+        }
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < blocks; i++, in += 32) {
+            __m256i v = load(in);
+            // cmpeq yields 0xFF (= -1) for matching bytes => subtract to count
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(v, vend));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(v, vesc));
+        }
+        __m256i sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+        count += static_cast<size_t>(_mm256_extract_epi64(sums, 0))
+               + static_cast<size_t>(_mm256_extract_epi64(sums, 1))
+               + static_cast<size_t>(_mm256_extract_epi64(sums, 2))
+               + static_cast<size_t>(_mm256_extract_epi64(sums, 3));
+    }
+    return count + sse42_kernels.count_special(in, static_cast<size_t>(inend - in));
+}
+
+SLIPSTREAM_TARGET("avx2")
+const uint8_t* avx2_find_special(const uint8_t* in, const uint8_t* inend) {
+    for (; inend - in >= 32; in += 32) {
+        uint32_t mask = special_mask(load(in));
+        if (mask != 0) {
+            return in + lowest_set_bit(mask);
+        }
+    }
+    return sse42_kernels.find_special(in, inend);
+}
+
+/**
+ * See sse42_encode_bulk() for a description of the algorithm.
+ */
+SLIPSTREAM_TARGET("avx2")
+void avx2_encode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    // Work on local copies: Stores through uint8_t* may alias the references,
+    // which would force the compiler to reload them after every byte written.
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    while (inend - in >= 2 * 32 && outend - out > 3 * 32) {
+        __m256i v = load(in);
+        uint32_t mask = special_mask(v);
+        if (mask == 0) {
+            store(out, v);
+            in += 32;
+            out += 32;
+            continue;
+        }
+        unsigned pos = 0; // First byte in the block which has not been encoded yet
+        while (mask != 0) {
+            unsigned special = lowest_set_bit(mask);
+            // Copy the clean run [pos, special) (plus garbage which will be overwritten)
+            store(out, load(in + pos));
+            out += special - pos;
+            *out++ = ESC;
+            *out++ = (in[special] == END) ? ESCEND : ESCESC;
+            pos = special + 1;
+            mask &= mask - 1; // Clear lowest set bit
+        }
+        // Copy the clean run after the last special byte
+        store(out, load(in + pos));
+        out += 32 - pos;
+        in += 32;
+    }
+    sse42_kernels.encode_bulk(in, inend, out, outend);
+    inref = in;
+    outref = out;
+}
+
+/**
+ * See sse42_decode_bulk() for a description of the algorithm.
+ */
+SLIPSTREAM_TARGET("avx2")
+void avx2_decode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    // Work on local copies, see avx2_encode_bulk()
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    while (inend - in >= 2 * 32 && outend - out >= 2 * 32) {
+        __m256i v = load(in);
+        uint32_t mask = special_mask(v);
+        if (mask == 0) {
+            store(out, v);
+            in += 32;
+            out += 32;
+            continue;
+        }
+        unsigned pos = 0; // First byte in the block which has not been decoded yet
+        while (mask != 0) {
+            unsigned special = lowest_set_bit(mask);
+            if (special != pos) {
+                // Copy the clean run [pos, special) (plus garbage which will be overwritten)
+                store(out, load(in + pos));
+                out += special - pos;
+            }
+            uint8_t next = in[special + 1]; // Always valid: at least two vectors of input remain
+            if (in[special] == END || (next != ESCEND && next != ESCESC)) {
+                // End of packet or invalid escape: Let the caller handle it
+                inref = in + special;
+                outref = out;
+                return;
+            }
+            *out++ = (next == ESCEND) ? END : ESC;
+            pos = special + 2;
+            mask &= mask - 1; // Clear lowest set bit
+        }
+        if (pos < 32) {
+            // Copy the clean run after the last escape sequence
+            store(out, load(in + pos));
+            out += 32 - pos;
+            pos = 32;
+        }
+        // If the escaped byte was the first byte of the next block, that one is skipped
+        in += pos;
+    }
+    sse42_kernels.decode_bulk(in, inend, out, outend);
+    inref = in;
+    outref = out;
+}
+
+} // namespace
+
+const KernelTable avx2_kernels = {
+    Kernel::AVX2,
+    avx2_count_special,
+    avx2_find_special,
+    avx2_encode_bulk,
+    avx2_decode_bulk,
+    crc32_update_pclmul, // Replaced by the lookup table CRC32 without PCLMULQDQ (Dispatch.cpp)
+    crc32_update_pclmul_x4,
+    crc32c_update_sse42 // Replaced by crc32c_update_sse42_serial() without PCLMULQDQ
+};
+
+} // namespace detail
+} // namespace SLIPStream
+
+#endif // SLIPSTREAM_X86_64
@@ -0,0 +1,246 @@
+/**
+ * @file KernelsGeneric.cpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * Portable scalar and SWAR (64-bit word-at-a-time) kernels.
+ * These are available on every platform, including ESP32.
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#include "Kernels.hpp"
+#include "SLIPStream/SLIP.hpp"
+#include <cstring>
+
+namespace SLIPStream {
+namespace detail {
+
+namespace {
+
+// ============================================================================
+// Scalar kernels
+// ============================================================================
+
+size_t scalar_count_special(const uint8_t* in, size_t inlen) {
+    size_t count = 0;
+    const uint8_t* inend = in + inlen; // First character AFTER the input
+    for (; in < inend; in++) {
+        if (*in == END || *in == ESC) {
+            count++;
+        }
+    }
+    return count;
+}
+
+const uint8_t* scalar_find_special(const uint8_t* in, const uint8_t* inend) {
+    for (; in < inend; in++) {
+        if (*in == END || *in == ESC) {
+            return in;
+        }
+    }
+    return inend;
+}
+
+void scalar_encode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    // Work on local copies: Stores through uint8_t* may alias the references,
+    // which would force the compiler to reload them after every byte written.
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    // Every input byte produces at most two output bytes, so by limiting the number of
+    // input bytes (keeping one byte for END) no further bounds checks are required.
+    size_t n = static_cast<size_t>(inend - in);
+    size_t room = static_cast<size_t>(outend - out);
+    if (room > 0 && n > (room - 1) / 2) {
+        n = (room - 1) / 2;
+    } else if (room == 0) {
+        n = 0;
+    }
+    for (const uint8_t* blockend = in + n; in < blockend; in++) {
+        uint8_t c = *in;
+        if (c == END) {
+            *out++ = ESC;
+            *out++ = ESCEND;
+        } else if (c == ESC) {
+            *out++ = ESC;
+            *out++ = ESCESC;
+        } else {
+            *out++ = c;
+        }
+    }
+    inref = in;
+    outref = out;
+}
+
+void scalar_decode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    // Decoding never produces more bytes than it consumes, so by limiting the number
+    // of input bytes no further bounds checks are required. One byte of input is
+    // kept back so an ESC can always be followed by the escaped byte.
+    size_t n = (inend - in > 0) ? static_cast<size_t>(inend - in) - 1 : 0;
+    if (n > static_cast<size_t>(outend - out)) {
+        n = static_cast<size_t>(outend - out);
+    }
+    for (const uint8_t* blockend = in + n; in < blockend;) {
+        uint8_t c = *in;
+        if (c == END) {
+            break; // End of packet: Let the caller handle it
+        }
+        if (c == ESC) {
+            uint8_t next = in[1];
+            if (next != ESCEND && next != ESCESC) {
+                break; // Invalid escape sequence: Let the caller handle it
+            }
+            *out++ = (next == ESCEND) ? END : ESC;
+            in += 2;
+        } else {
+            *out++ = c;
+            in++;
+        }
+    }
+    inref = in;
+    outref = out;
+}
+
+// ============================================================================
+// SWAR kernels
+// ============================================================================
+
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+constexpr uint64_t LOW7 = 0x7F7F7F7F7F7F7F7FULL;
+
+/**
+ * Load 8 bytes so that the first byte is in the least significant position
+ */
+inline uint64_t load_word(const uint8_t* p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+/**
+ * @return A word with the high bit of every byte set if that byte of [x] is zero.
+ * Unlike the common (x - ONES) & ~x trick this has no false positives.
+ */
+inline uint64_t zero_bytes(uint64_t x) {
+    return ~(((x & LOW7) + LOW7) | x | LOW7);
+}
+
+/**
+ * @return A word with the high bit of every END or ESC byte set
+ */
+inline uint64_t special_bytes(uint64_t w) {
+    return zero_bytes(w ^ (ONES * END)) | zero_bytes(w ^ (ONES * ESC));
+}
+
+size_t swar_count_special(const uint8_t* in, size_t inlen) {
+    size_t count = 0;
+    const uint8_t* inend = in + inlen;
+    for (; inend - in >= 8; in += 8) {
+        // Move the flag bits to the lowest bit of each byte, then sum up all bytes
+        uint64_t flags = special_bytes(load_word(in)) >> 7;
+        count += static_cast<size_t>((flags * ONES) >> 56);
+    }
+    return count + scalar_count_special(in, static_cast<size_t>(inend - in));
+}
+
+const uint8_t* swar_find_special(const uint8_t* in, const uint8_t* inend) {
+    for (; inend - in >= 8; in += 8) {
+        uint64_t mask = special_bytes(load_word(in));
+        if (mask != 0) {
+            return in + lowest_set_bit(mask) / 8;
+        }
+    }
+    return scalar_find_special(in, inend);
+}
+
+void swar_encode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    // Worst case output for one word is 16 bytes, plus one byte for END
+    while (inend - in >= 8 && outend - out > 2 * 8) {
+        uint64_t mask = special_bytes(load_word(in));
+        if (mask == 0) {
+            memcpy(out, in, 8);
+            in += 8;
+            out += 8;
+            continue;
+        }
+        for (const uint8_t* blockend = in + 8; in < blockend; in++) {
+            uint8_t c = *in;
+            if (c == END || c == ESC) {
+                *out++ = ESC;
+                *out++ = (c == END) ? ESCEND : ESCESC;
+            } else {
+                *out++ = c;
+            }
+        }
+    }
+    inref = in;
+    outref = out;
+}
+
+void swar_decode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    // An ESC in the last byte of a word needs one more byte of input
+    while (inend - in > 8 && outend - out >= 8) {
+        uint64_t mask = special_bytes(load_word(in));
+        if (mask == 0) {
+            memcpy(out, in, 8);
+            in += 8;
+            out += 8;
+            continue;
+        }
+        for (const uint8_t* blockend = in + 8; in < blockend;) {
+            uint8_t c = *in;
+            if (c == ESC) {
+                uint8_t next = in[1];
+                if (next != ESCEND && next != ESCESC) {
+                    goto done; // Invalid escape sequence: Let the caller handle it
+                }
+                *out++ = (next == ESCEND) ? END : ESC;
+                in += 2;
+            } else if (c == END) {
+                goto done; // End of packet: Let the caller handle it
+            } else {
+                *out++ = c;
+                in++;
+            }
+        }
+    }
+done:
+    inref = in;
+    outref = out;
+}
+
+} // namespace
+
+const KernelTable scalar_kernels = {
+    Kernel::Scalar,
+    scalar_count_special,
+    scalar_find_special,
+    scalar_encode_bulk,
+    scalar_decode_bulk,
+    crc32_update_table,
+    crc32_update_table_x4,
+    crc32c_update_table
+};
+
+const KernelTable swar_kernels = {
+    Kernel::SWAR,
+    swar_count_special,
+    swar_find_special,
+    swar_encode_bulk,
+    swar_decode_bulk,
+    crc32_update_table,
+    crc32_update_table_x4,
+    crc32c_update_table
+};
+
+} // namespace detail
+} // namespace SLIPStream
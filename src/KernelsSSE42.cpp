@@ -0,0 +1,415 @@
+/**
+ * @file KernelsSSE42.cpp
+ * @author Uli Köhler <github@techoverflow.net>
+ * @version 1.0
+ * @date 2025-08-19
+ *
+ * x86-64 kernels processing 16 bytes per iteration (SSE4.2 & POPCNT),
+ * and the CRC kernels using carry-less multiplication (PCLMULQDQ),
+ * which are only used if the CPU supports it as well.
+ * Compiled using function-level target attributes and only called
+ * after the CPU has been checked for support (see Dispatch.cpp).
+ *
+ * @copyright Copyright (C) 2022..2025 Uli Köhler
+ */
+#include "Kernels.hpp"
+
+#if defined(SLIPSTREAM_X86_64)
+#include "SLIPStream/SLIP.hpp"
+#include <cstring>
+#include <immintrin.h>
+
+namespace SLIPStream {
+namespace detail {
+
+namespace {
+
+/**
+ * @return Bitmask of the END and ESC bytes in [v]
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+inline uint32_t special_mask(__m128i v) {
+    const __m128i vend = _mm_set1_epi8(static_cast<char>(END));
+    const __m128i vesc = _mm_set1_epi8(static_cast<char>(ESC));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, vend), _mm_cmpeq_epi8(v, vesc));
+    return static_cast<uint32_t>(_mm_movemask_epi8(m));
+}
+
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+inline __m128i load(const uint8_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+inline void store(uint8_t* p, __m128i v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+size_t sse42_count_special(const uint8_t* in, size_t inlen) {
+    size_t count = 0;
+    const uint8_t* inend = in + inlen;
+    for (; inend - in >= 16; in += 16) {
+        count += static_cast<size_t>(_mm_popcnt_u32(special_mask(load(in))));
+    }
+    for (; in < inend; in++) {
+        if (*in == END || *in == ESC) {
+            count++;
+        }
+    }
+    return count;
+}
+
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+const uint8_t* sse42_find_special(const uint8_t* in, const uint8_t* inend) {
+    for (; inend - in >= 16; in += 16) {
+        uint32_t mask = special_mask(load(in));
+        if (mask != 0) {
+            return in + lowest_set_bit(mask);
+        }
+    }
+    for (; in < inend; in++) {
+        if (*in == END || *in == ESC) {
+            return in;
+        }
+    }
+    return inend;
+}
+
+/**
+ * Clean vectors are stored as a whole, otherwise the special bytes are visited in
+ * order using the movemask bits: the clean run before each special byte is copied
+ * using one (unaligned) vector store, followed by the escape pair.
+ *
+ * Stops as soon as less than two vectors of input remain (the run copies may read up
+ * to one vector past the current block) or [out] does not have room for the worst
+ * case output of one block (two vectors), one extra vector store and the trailing END.
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+void sse42_encode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    // Work on local copies: Stores through uint8_t* may alias the references,
+    // which would force the compiler to reload them after every byte written.
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    while (inend - in >= 2 * 16 && outend - out > 3 * 16) {
+        __m128i v = load(in);
+        uint32_t mask = special_mask(v);
+        if (mask == 0) {
+            store(out, v);
+            in += 16;
+            out += 16;
+            continue;
+        }
+        unsigned pos = 0; // First byte in the block which has not been encoded yet
+        while (mask != 0) {
+            unsigned special = lowest_set_bit(mask);
+            // Copy the clean run [pos, special) (plus garbage which will be overwritten)
+            store(out, load(in + pos));
+            out += special - pos;
+            *out++ = ESC;
+            *out++ = (in[special] == END) ? ESCEND : ESCESC;
+            pos = special + 1;
+            mask &= mask - 1; // Clear lowest set bit
+        }
+        // Copy the clean run after the last special byte
+        store(out, load(in + pos));
+        out += 16 - pos;
+        in += 16;
+    }
+    inref = in;
+    outref = out;
+}
+
+/**
+ * Same block structure as sse42_encode_bulk(). Valid escape sequences are resolved
+ * scalar-wise, stops at the first END byte or invalid escape sequence.
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+void sse42_decode_bulk(const uint8_t*& inref, const uint8_t* inend, uint8_t*& outref, const uint8_t* outend) {
+    // Work on local copies, see sse42_encode_bulk()
+    const uint8_t* in = inref;
+    uint8_t* out = outref;
+    while (inend - in >= 2 * 16 && outend - out >= 2 * 16) {
+        __m128i v = load(in);
+        uint32_t mask = special_mask(v);
+        if (mask == 0) {
+            store(out, v);
+            in += 16;
+            out += 16;
+            continue;
+        }
+        unsigned pos = 0; // First byte in the block which has not been decoded yet
+        while (mask != 0) {
+            unsigned special = lowest_set_bit(mask);
+            if (special != pos) {
+                // Copy the clean run [pos, special) (plus garbage which will be overwritten)
+                store(out, load(in + pos));
+                out += special - pos;
+            }
+            uint8_t next = in[special + 1]; // Always valid: at least two vectors of input remain
+            if (in[special] == END || (next != ESCEND && next != ESCESC)) {
+                // End of packet or invalid escape: Let the caller handle it
+                inref = in + special;
+                outref = out;
+                return;
+            }
+            *out++ = (next == ESCEND) ? END : ESC;
+            pos = special + 2;
+            mask &= mask - 1; // Clear lowest set bit
+        }
+        if (pos < 16) {
+            // Copy the clean run after the last escape sequence
+            store(out, load(in + pos));
+            out += 16 - pos;
+            pos = 16;
+        }
+        // If the escaped byte was the first byte of the next block, that one is skipped
+        in += pos;
+    }
+    inref = in;
+    outref = out;
+}
+
+/**
+ * x^n mod G(x) for the CRC32 generator G(x) = x^32 + CRC32_TABLE_POLYNOMIAL
+ */
+constexpr uint64_t crc32_xpow_mod(unsigned n) {
+    uint32_t r = 1;
+    for (unsigned i = 0; i < n; i++) {
+        r = (r & 0x80000000u) ? ((r << 1) ^ CRC32_TABLE_POLYNOMIAL) : (r << 1);
+    }
+    return r;
+}
+
+// Folding constants for 128 bits (one accumulator) and 512 bits (four accumulators)
+constexpr uint64_t CRC32_FOLD128_HI = crc32_xpow_mod(128 + 64);
+constexpr uint64_t CRC32_FOLD128_LO = crc32_xpow_mod(128);
+constexpr uint64_t CRC32_FOLD512_HI = crc32_xpow_mod(512 + 64);
+constexpr uint64_t CRC32_FOLD512_LO = crc32_xpow_mod(512);
+
+// Minimum length for the four accumulators (shorter data uses the table-driven CRC32)
+constexpr size_t CRC32_PCLMUL_THRESHOLD = 64;
+
+/**
+ * Load 16 bytes so that the first byte is the most significant one (MSB-first CRC)
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+inline __m128i load_be128(const uint8_t* p) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(load(p), reverse);
+}
+
+/**
+ * Multiply the 128 bit polynomial [acc] by x^(N + 64) (high half) and x^N (low half)
+ * modulo G, where k = [x^(N + 64) mod G : x^N mod G]. The result has at most 96 bits.
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+inline __m128i fold(__m128i acc, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x11), _mm_clmulepi64_si128(acc, k, 0x00));
+}
+
+} // namespace
+
+/**
+ * Folding CRC32 using carry-less multiplication (see Intel's "Fast CRC Computation
+ * for Generic Polynomials Using PCLMULQDQ Instruction"), MSB-first variant.
+ * The data is folded into four 128 bit accumulators (64 bytes per iteration), which are
+ * then folded into one. The accumulator is congruent to the data (including the initial
+ * CRC) modulo G, so the table-driven CRC of its 16 bytes is the CRC of the data.
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+uint32_t crc32_update_pclmul(uint32_t crc, const uint8_t* data, size_t length) {
+    if (length < CRC32_PCLMUL_THRESHOLD) {
+        return crc32_update_table(crc, data, length);
+    }
+    const __m128i k128 = _mm_set_epi64x(static_cast<int64_t>(CRC32_FOLD128_HI), static_cast<int64_t>(CRC32_FOLD128_LO));
+    const __m128i k512 = _mm_set_epi64x(static_cast<int64_t>(CRC32_FOLD512_HI), static_cast<int64_t>(CRC32_FOLD512_LO));
+    const uint8_t* end = data + (length & ~static_cast<size_t>(15));
+    // The initial CRC is XORed into the first 4 bytes
+    __m128i a0 = _mm_xor_si128(load_be128(data), _mm_set_epi32(static_cast<int>(crc), 0, 0, 0));
+    __m128i a1 = load_be128(data + 16);
+    __m128i a2 = load_be128(data + 32);
+    __m128i a3 = load_be128(data + 48);
+    data += 64;
+    while (end - data >= 64) {
+        a0 = _mm_xor_si128(fold(a0, k512), load_be128(data));
+        a1 = _mm_xor_si128(fold(a1, k512), load_be128(data + 16));
+        a2 = _mm_xor_si128(fold(a2, k512), load_be128(data + 32));
+        a3 = _mm_xor_si128(fold(a3, k512), load_be128(data + 48));
+        data += 64;
+    }
+    __m128i acc = _mm_xor_si128(fold(a0, k128), a1);
+    acc = _mm_xor_si128(fold(acc, k128), a2);
+    acc = _mm_xor_si128(fold(acc, k128), a3);
+    while (data < end) {
+        acc = _mm_xor_si128(fold(acc, k128), load_be128(data));
+        data += 16;
+    }
+    // Reduce the accumulator by processing its bytes (most significant first)
+    uint8_t bytes[16];
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_shuffle_epi8(acc, reverse));
+    crc = crc32_update_table(0, bytes, sizeof(bytes));
+    // Remaining bytes which do not fill a 128 bit block
+    return crc32_update_table(crc, end, length & 15);
+}
+
+/**
+ * Four buffers folded in lockstep, one 128 bit accumulator each. A single accumulator
+ * is limited by the latency of PCLMULQDQ, four independent ones keep it busy.
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+void crc32_update_pclmul_x4(uint32_t* crcs, const uint8_t* const* bufs, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    const __m128i k128 = _mm_set_epi64x(static_cast<int64_t>(CRC32_FOLD128_HI), static_cast<int64_t>(CRC32_FOLD128_LO));
+    __m128i a0 = _mm_xor_si128(load_be128(bufs[0]), _mm_set_epi32(static_cast<int>(crcs[0]), 0, 0, 0));
+    __m128i a1 = _mm_xor_si128(load_be128(bufs[1]), _mm_set_epi32(static_cast<int>(crcs[1]), 0, 0, 0));
+    __m128i a2 = _mm_xor_si128(load_be128(bufs[2]), _mm_set_epi32(static_cast<int>(crcs[2]), 0, 0, 0));
+    __m128i a3 = _mm_xor_si128(load_be128(bufs[3]), _mm_set_epi32(static_cast<int>(crcs[3]), 0, 0, 0));
+    for (size_t pos = 16; pos < length; pos += 16) {
+        a0 = _mm_xor_si128(fold(a0, k128), load_be128(bufs[0] + pos));
+        a1 = _mm_xor_si128(fold(a1, k128), load_be128(bufs[1] + pos));
+        a2 = _mm_xor_si128(fold(a2, k128), load_be128(bufs[2] + pos));
+        a3 = _mm_xor_si128(fold(a3, k128), load_be128(bufs[3] + pos));
+    }
+    // Reduce the accumulators like crc32_update_pclmul()
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint8_t bytes[4][16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes[0]), _mm_shuffle_epi8(a0, reverse));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes[1]), _mm_shuffle_epi8(a1, reverse));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes[2]), _mm_shuffle_epi8(a2, reverse));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes[3]), _mm_shuffle_epi8(a3, reverse));
+    for (size_t i = 0; i < 4; i++) {
+        crcs[i] = crc32_update_table(0, bytes[i], 16);
+    }
+}
+
+namespace {
+
+/**
+ * x^n mod P(x) for the CRC-32C polynomial, bit-reflected like the CRC-32C register
+ */
+constexpr uint32_t crc32c_xpow_mod(unsigned n) {
+    uint32_t r = 1;
+    for (unsigned i = 0; i < n; i++) {
+        r = (r & 0x80000000u) ? ((r << 1) ^ static_cast<uint32_t>(Crc32C::polynomial)) : (r << 1);
+    }
+    return static_cast<uint32_t>(crc_reflect(r, 32));
+}
+
+// Bytes per lane of the three interleaved crc32 instruction streams. The crc32
+// instruction has a latency of 3 cycles but a throughput of 1 per cycle, so three
+// independent streams are needed to saturate it. The lanes are combined afterwards,
+// long lanes for the bulk of the data, short lanes for the remainder.
+constexpr size_t CRC32C_LANE_LONG = 8192;
+constexpr size_t CRC32C_LANE_SHORT = 256;
+
+// Constants for crc32c_shift(): x^(8 * lane - 33) mod P
+constexpr uint32_t CRC32C_SHIFT_LONG = crc32c_xpow_mod(8 * CRC32C_LANE_LONG - 33);
+constexpr uint32_t CRC32C_SHIFT_SHORT = crc32c_xpow_mod(8 * CRC32C_LANE_SHORT - 33);
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * The CRC-32C register [crc] followed by one lane of zero bytes, given its shift constant k.
+ * The carry-less product of the reflected values is crc * k * x^-1, which the crc32
+ * instruction multiplies by x^32 and reduces modulo P: crc * x^(8 * lane).
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+inline uint32_t crc32c_shift(uint32_t crc, uint32_t k) {
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)), _mm_cvtsi32_si128(static_cast<int>(k)), 0x00);
+    return static_cast<uint32_t>(_mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product))));
+}
+
+/**
+ * Process [count] blocks of three interleaved lanes of [lane] bytes each
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+inline uint32_t crc32c_lanes(uint32_t crc, const uint8_t*& data, size_t& length, size_t lane, uint32_t k) {
+    while (length >= 3 * lane) {
+        uint64_t crc0 = crc;
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const uint8_t* end = data + lane;
+        do {
+            crc0 = _mm_crc32_u64(crc0, load64(data));
+            crc1 = _mm_crc32_u64(crc1, load64(data + lane));
+            crc2 = _mm_crc32_u64(crc2, load64(data + 2 * lane));
+            data += 8;
+        } while (data < end);
+        crc = crc32c_shift(static_cast<uint32_t>(crc0), k) ^ static_cast<uint32_t>(crc1);
+        crc = crc32c_shift(crc, k) ^ static_cast<uint32_t>(crc2);
+        data += 2 * lane;
+        length -= 3 * lane;
+    }
+    return crc;
+}
+
+/**
+ * A single stream of crc32 instructions, 8 bytes at a time
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+inline uint32_t crc32c_serial(uint32_t crc, const uint8_t* data, size_t length) {
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        crc64 = _mm_crc32_u64(crc64, load64(data));
+        data += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+        length--;
+    }
+    return crc;
+}
+
+} // namespace
+
+/**
+ * CRC-32C using the SSE4.2 crc32 instruction on three interleaved lanes, which are
+ * combined using carry-less multiplication (see Intel's "Fast CRC Computation for
+ * iSCSI Polynomial Using CRC32 Instruction").
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt,pclmul")
+uint32_t crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t length) {
+    // Align to 8 bytes
+    while (length > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+        length--;
+    }
+    crc = crc32c_lanes(crc, data, length, CRC32C_LANE_LONG, CRC32C_SHIFT_LONG);
+    crc = crc32c_lanes(crc, data, length, CRC32C_LANE_SHORT, CRC32C_SHIFT_SHORT);
+    return crc32c_serial(crc, data, length);
+}
+
+/**
+ * CRC-32C using the SSE4.2 crc32 instruction without combining lanes,
+ * for CPUs without PCLMULQDQ (about a third of the throughput)
+ */
+SLIPSTREAM_TARGET("sse4.2,popcnt")
+uint32_t crc32c_update_sse42_serial(uint32_t crc, const uint8_t* data, size_t length) {
+    return crc32c_serial(crc, data, length);
+}
+
+const KernelTable sse42_kernels = {
+    Kernel::SSE42,
+    sse42_count_special,
+    sse42_find_special,
+    sse42_encode_bulk,
+    sse42_decode_bulk,
+    crc32_update_pclmul, // Replaced by the lookup table CRC32 without PCLMULQDQ (Dispatch.cpp)
+    crc32_update_pclmul_x4,
+    crc32c_update_sse42 // Replaced by crc32c_update_sse42_serial() without PCLMULQDQ
+};
+
+} // namespace detail
+} // namespace SLIPStream
+
+#endif // SLIPSTREAM_X86_64
@@ -0,0 +1,122 @@
+// Tests for the sink-templated encoder with inline queue (SLIPStream/BasicEncoder.hpp)
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "SLIPStream/BasicEncoder.hpp"
+#include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/SLIP.hpp"
+
+using namespace SLIPStream;
+
+namespace {
+
+// Sink writing into a vector, accepting at most maxPerCall bytes per call and budget bytes in total
+struct VectorSink {
+    std::vector<uint8_t>* out;
+    size_t maxPerCall = SIZE_MAX;
+    size_t* budget = nullptr;
+
+    std::pair<WriteStatus, size_t> operator()(const uint8_t* data, size_t length) {
+        size_t n = std::min(length, maxPerCall);
+        if (budget != nullptr) {
+            n = std::min(n, *budget);
+            *budget -= n;
+        }
+        out->insert(out->end(), data, data + n);
+        return {WriteStatus::Ok, n};
+    }
+};
+
+std::vector<uint8_t> make_payload(size_t size) {
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; i++) {
+        payload[i] = static_cast<uint8_t>((i * 29) ^ (i >> 2));
+        if (i % 11 == 0) payload[i] = END;
+        if (i % 19 == 0) payload[i] = ESC;
+    }
+    return payload;
+}
+
+} // namespace
+
+TEST(SLIPBasicEncoder, FixedCapacityIsInline) {
+    using FixedEncoder = BasicEncoder<VectorSink, 256>;
+    EXPECT_GE(sizeof(FixedEncoder), 256u);
+    EXPECT_FALSE((std::is_constructible_v<BasicEncoder<VectorSink, 256>, VectorSink, size_t, size_t>));
+    std::vector<uint8_t> out;
+    FixedEncoder enc(VectorSink{&out});
+    EXPECT_EQ(enc.capacity(), 256u);
+    EXPECT_EQ(enc.free(), 256u);
+}
+
+TEST(SLIPBasicEncoder, MatchesEncodePacket) {
+    std::vector<uint8_t> payload = make_payload(700);
+    std::vector<uint8_t> expected(max_encoded_length(payload.size()));
+    expected.resize(encode_packet(payload.data(), payload.size(), expected.data(), expected.size()));
+    std::vector<uint8_t> out;
+    BasicEncoder<VectorSink, 64> enc(VectorSink{&out}, 16);
+    for (int packet = 0; packet < 3; packet++) {
+        out.clear();
+        auto [status, consumed] = enc.pushPacket(payload.data(), payload.size());
+        EXPECT_EQ(status, WriteStatus::Ok);
+        EXPECT_EQ(consumed, payload.size());
+        while (enc.queued() > 0) {
+            ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+        }
+        EXPECT_EQ(out, expected) << "packet=" << packet;
+    }
+}
+
+TEST(SLIPBasicEncoder, WrapAroundWithBackpressure) {
+    std::vector<uint8_t> payload = make_payload(300);
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+    // Tiny ring, short writes and an output which blocks every 10 bytes
+    std::vector<uint8_t> out;
+    size_t budget = 0;
+    BasicEncoder<VectorSink, 8> enc(VectorSink{&out, 3, &budget}, 5);
+    enc.setAppendCrc32(true);
+    size_t offset = 0;
+    for (int attempt = 0; attempt < 10000 && offset < payload.size(); attempt++) {
+        budget = 10;
+        auto [status, consumed] = enc.pushPacket(payload.data() + offset, payload.size() - offset);
+        ASSERT_NE(status, WriteStatus::Error);
+        offset += consumed;
+    }
+    // Only the trailer may be left: flush() completes it
+    budget = SIZE_MAX;
+    do {
+        ASSERT_NE(enc.flush(), WriteStatus::Error);
+    } while (enc.queued() > 0);
+    EXPECT_EQ(out, expected);
+}
+
+TEST(SLIPBasicEncoder, FunctionPointerSinkAndDynamicCapacity) {
+    static std::vector<uint8_t> out;
+    out.clear();
+    using SinkFn = std::pair<WriteStatus, size_t> (*)(const uint8_t*, size_t);
+    SinkFn sink = [](const uint8_t* data, size_t length) {
+        out.insert(out.end(), data, data + length);
+        return std::make_pair(WriteStatus::Ok, length);
+    };
+    // Any queue size with DynamicCapacity
+    BasicEncoder<SinkFn> enc(sink, 5, 64);
+    EXPECT_EQ(enc.capacity(), 5u);
+    const uint8_t payload[] = {0x01, END, 0x02};
+    auto [status, consumed] = enc.pushPacket(payload, sizeof(payload));
+    EXPECT_EQ(status, WriteStatus::Ok);
+    EXPECT_EQ(consumed, sizeof(payload));
+    std::vector<uint8_t> expected = {0x01, ESC, ESCEND, 0x02, END};
+    EXPECT_EQ(out, expected);
+}
+
+TEST(SLIPBasicEncoder, SinkError) {
+    auto failing = [](const uint8_t*, size_t) { return std::make_pair(WriteStatus::Error, size_t(0)); };
+    BasicEncoder<decltype(failing), 16> enc(failing, 4);
+    const uint8_t payload[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    auto result = enc.pushPacket_ex(payload, sizeof(payload));
+    EXPECT_TRUE(result.is_error());
+    EXPECT_EQ(result.error.code, ErrorCode::EncodeInternalError);
+}
@@ -1,9 +1,11 @@
 // Comprehensive tests for Buffer API with enhanced error reporting
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <vector>
 #include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
 
 using namespace SLIPStream;
 
@@ -321,3 +323,568 @@ TEST_F(SLIPBufferEnhancedTest, AllSpecialBytes) {
     EXPECT_EQ(dec_result.value, sizeof(special));
     EXPECT_EQ(0, std::memcmp(special, decoded.data(), sizeof(special)));
 }
+
+// ============================================================================
+// Vectorized kernel tests (lengths spanning several SIMD blocks + tails)
+// ============================================================================
+
+static size_t reference_encoded_length(const std::vector<uint8_t>& data) {
+    size_t len = 1;
+    for (uint8_t b : data) {
+        len += (b == END || b == ESC) ? 2 : 1;
+    }
+    return len;
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodedLengthMatchesReferenceAllLengths) {
+    for (size_t len = 0; len <= 200; len++) {
+        std::vector<uint8_t> data(len);
+        for (size_t i = 0; i < len; i++) {
+            // Deterministic mix of ordinary and special bytes
+            uint32_t r = static_cast<uint32_t>(i * 2654435761u + len);
+            data[i] = (r % 7 == 0) ? END : (r % 11 == 0) ? ESC : static_cast<uint8_t>(r >> 8);
+        }
+        EXPECT_EQ(encoded_length(data.data(), data.size()), reference_encoded_length(data)) << "len=" << len;
+        EXPECT_EQ(encoded_length_ex(data.data(), data.size()).value, reference_encoded_length(data)) << "len=" << len;
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodedLengthLargeAllSpecial) {
+    // More than 255 SIMD blocks of matching bytes to exercise counter folding
+    std::vector<uint8_t> data(32 * 300 + 7, END);
+    for (size_t i = 1; i < data.size(); i += 2) {
+        data[i] = ESC;
+    }
+    EXPECT_EQ(encoded_length(data.data(), data.size()), 2 * data.size() + 1);
+}
+
+static std::vector<uint8_t> reference_encode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    for (uint8_t b : data) {
+        if (b == END) {
+            out.push_back(ESC);
+            out.push_back(ESCEND);
+        } else if (b == ESC) {
+            out.push_back(ESC);
+            out.push_back(ESCESC);
+        } else {
+            out.push_back(b);
+        }
+    }
+    out.push_back(END);
+    return out;
+}
+
+static std::vector<uint8_t> make_test_payload(size_t len, uint32_t special_every) {
+    std::vector<uint8_t> data(len);
+    for (size_t i = 0; i < len; i++) {
+        uint32_t r = static_cast<uint32_t>(i * 2654435761u + len);
+        uint8_t b = static_cast<uint8_t>(r >> 8);
+        if (b == END || b == ESC) {
+            b = 0x42;
+        }
+        if (special_every != 0 && (r % special_every) == 0) {
+            b = (r & 0x100) ? END : ESC;
+        }
+        data[i] = b;
+    }
+    return data;
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketMatchesReferenceAllLengths) {
+    for (uint32_t every : {0u, 1u, 3u, 17u, 100u}) {
+        for (size_t len = 0; len <= 150; len++) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> expected = reference_encode(data);
+            std::vector<uint8_t> out(expected.size());
+            ASSERT_EQ(encode_packet(data.data(), data.size(), out.data(), out.size()), expected.size());
+            EXPECT_EQ(out, expected) << "len=" << len << " every=" << every;
+            Result<size_t> res = encode_packet_ex(data.data(), data.size(), out.data(), out.size());
+            ASSERT_TRUE(res.is_success());
+            EXPECT_EQ(res.value, expected.size());
+            EXPECT_EQ(out, expected) << "len=" << len << " every=" << every;
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketRejectsEveryShortOutputLength) {
+    std::vector<uint8_t> data = make_test_payload(70, 9);
+    size_t needed = encoded_length(data.data(), data.size());
+    std::vector<uint8_t> out(needed);
+    for (size_t outlen = 0; outlen < needed; outlen++) {
+        EXPECT_EQ(encode_packet(data.data(), data.size(), out.data(), outlen), ENCODE_ERROR) << "outlen=" << outlen;
+        Result<size_t> res = encode_packet_ex(data.data(), data.size(), out.data(), outlen);
+        EXPECT_EQ(res.error.code, ErrorCode::EncodeBufferTooSmall) << "outlen=" << outlen;
+        EXPECT_LE(res.error.position, data.size());
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketExRunOverflowPosition) {
+    // 40 ordinary bytes + END fit exactly into a 41 byte buffer
+    std::vector<uint8_t> data(40, 0x42);
+    Result<size_t> res = encode_packet_ex(data.data(), data.size(), buffer.data(), 41);
+    EXPECT_TRUE(res.is_success());
+    // With one escaped byte, the last data byte does not fit anymore (one byte is reserved for END)
+    data[5] = END;
+    res = encode_packet_ex(data.data(), data.size(), buffer.data(), 41);
+    EXPECT_EQ(res.error.code, ErrorCode::EncodeBufferTooSmall);
+    EXPECT_EQ(res.error.position, 39u);
+    EXPECT_STREQ(res.error.message, "Output buffer too small for data byte");
+}
+
+// Byte-by-byte reference decoder, returns the error code and position like decode_packet_ex()
+static Result<size_t> reference_decode(const std::vector<uint8_t>& in, uint8_t* out, size_t outlen) {
+    size_t w = 0;
+    for (size_t i = 0; i < in.size(); i++) {
+        uint8_t c = in[i];
+        if (c == END) {
+            return Result<size_t>(w);
+        }
+        if (c == ESC) {
+            if (i + 1 >= in.size()) {
+                return Result<size_t>(ErrorCode::DecodeTruncatedEscape, w);
+            }
+            uint8_t n = in[++i];
+            if (n != ESCEND && n != ESCESC) {
+                return Result<size_t>(ErrorCode::DecodeInvalidEscapeSequence, w);
+            }
+            c = (n == ESCEND) ? END : ESC;
+        }
+        if (w >= outlen) {
+            return Result<size_t>(ErrorCode::DecodeBufferTooSmall, w);
+        }
+        out[w++] = c;
+    }
+    return Result<size_t>(ErrorCode::DecodeNoEndMarker, w);
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketMatchesReferenceAllLengths) {
+    for (uint32_t every : {0u, 1u, 3u, 17u, 100u}) {
+        for (size_t len = 0; len <= 150; len++) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> encoded = reference_encode(data);
+            // Trailing garbage after END must not be touched
+            encoded.insert(encoded.end(), {0x01, ESC, 0x02});
+            EXPECT_EQ(decoded_length(encoded.data(), encoded.size()), len);
+            EXPECT_EQ(decoded_length_ex(encoded.data(), encoded.size()).value, len);
+            std::vector<uint8_t> out(len + 64);
+            ASSERT_EQ(decode_packet(encoded.data(), encoded.size(), out.data(), out.size()), len);
+            EXPECT_TRUE(std::equal(data.begin(), data.end(), out.begin())) << "len=" << len << " every=" << every;
+            Result<size_t> res = decode_packet_ex(encoded.data(), encoded.size(), out.data(), len);
+            ASSERT_TRUE(res.is_success());
+            EXPECT_EQ(res.value, len);
+            EXPECT_TRUE(std::equal(data.begin(), data.end(), out.begin())) << "len=" << len << " every=" << every;
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketErrorsMatchReference) {
+    std::vector<uint8_t> data = make_test_payload(130, 13);
+    std::vector<uint8_t> encoded = reference_encode(data);
+    std::vector<uint8_t> out(200), ref_out(200);
+    // Output buffer too small at every possible length
+    for (size_t outlen = 0; outlen < data.size(); outlen++) {
+        Result<size_t> ref = reference_decode(encoded, ref_out.data(), outlen);
+        Result<size_t> res = decode_packet_ex(encoded.data(), encoded.size(), out.data(), outlen);
+        EXPECT_EQ(res.error.code, ErrorCode::DecodeBufferTooSmall);
+        EXPECT_EQ(res.error.position, ref.error.position) << "outlen=" << outlen;
+        EXPECT_EQ(decode_packet(encoded.data(), encoded.size(), out.data(), outlen), DECODE_ERROR);
+    }
+    // Invalid escape, truncated escape and missing END at every possible position
+    for (size_t cut = 0; cut < encoded.size(); cut++) {
+        std::vector<uint8_t> invalid(encoded.begin(), encoded.begin() + cut);
+        invalid.push_back(ESC);
+        std::vector<uint8_t> truncated = invalid;
+        invalid.push_back(0x42);
+        invalid.insert(invalid.end(), encoded.begin() + cut, encoded.end());
+        std::vector<uint8_t> noend(encoded.begin(), encoded.begin() + cut);
+        for (const std::vector<uint8_t>* in : {&invalid, &truncated, &noend}) {
+            Result<size_t> ref = reference_decode(*in, ref_out.data(), ref_out.size());
+            Result<size_t> res = decode_packet_ex(in->data(), in->size(), out.data(), out.size());
+            Result<size_t> len = decoded_length_ex(in->data(), in->size());
+            EXPECT_EQ(res.error.code, ref.error.code) << "cut=" << cut;
+            EXPECT_EQ(res.error.position, ref.error.position) << "cut=" << cut;
+            EXPECT_EQ(len.error.code, ref.error.code) << "cut=" << cut;
+            EXPECT_EQ(len.error.position, ref.error.position) << "cut=" << cut;
+            if (ref.is_error()) {
+                EXPECT_EQ(decode_packet(in->data(), in->size(), out.data(), out.size()), DECODE_ERROR);
+                EXPECT_EQ(decoded_length(in->data(), in->size()), DECODE_ERROR);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Single-pass encoding into a worst-case sized buffer
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, MaxEncodedLengthIsConstexpr) {
+    static_assert(max_encoded_length(0) == 1, "Empty packet is a single END byte");
+    static_assert(max_encoded_length(10) == 21, "Every byte escaped plus END");
+    uint8_t out[max_encoded_length(4)];
+    EXPECT_EQ(sizeof(out), 9u);
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketMaxMatchesReference) {
+    for (uint32_t every : {0u, 1u, 3u, 17u, 100u}) {
+        for (size_t len = 0; len <= 150; len++) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> expected = reference_encode(data);
+            std::vector<uint8_t> out(max_encoded_length(len));
+            size_t n = encode_packet_max(data.data(), data.size(), out.data(), out.size());
+            ASSERT_EQ(n, expected.size());
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out.begin())) << "len=" << len << " every=" << every;
+            Result<size_t> res = encode_packet_max_ex(data.data(), data.size(), out.data(), out.size());
+            ASSERT_TRUE(res.is_success());
+            EXPECT_EQ(res.value, expected.size());
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketMaxRejectsSmallerBuffer) {
+    // Even though the encoded data (no special bytes) would fit, the buffer must have the worst case size
+    std::vector<uint8_t> data(20, 0x42);
+    std::vector<uint8_t> out(max_encoded_length(data.size()));
+    EXPECT_EQ(encode_packet_max(data.data(), data.size(), out.data(), out.size() - 1), ENCODE_ERROR);
+    Result<size_t> res = encode_packet_max_ex(data.data(), data.size(), out.data(), out.size() - 1);
+    EXPECT_EQ(res.error.code, ErrorCode::EncodeBufferTooSmall);
+    EXPECT_EQ(res.error.position, 0u);
+    // Sizes which would overflow the worst case calculation are rejected as well
+    EXPECT_EQ(encode_packet_max(data.data(), SIZE_MAX / 2 + 1, out.data(), SIZE_MAX), ENCODE_ERROR);
+}
+
+// ============================================================================
+// Cursor-style decoding of buffers containing multiple frames
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketConsumedWalksAllFrames) {
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> stream;
+    for (size_t len : {0u, 1u, 5u, 40u, 100u, 3u}) {
+        frames.push_back(make_test_payload(len, 7));
+        std::vector<uint8_t> encoded = reference_encode(frames.back());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    const uint8_t* in = stream.data();
+    size_t inlen = stream.size();
+    std::vector<uint8_t> out(256);
+    for (const std::vector<uint8_t>& frame : frames) {
+        size_t consumed = 0;
+        size_t len = decode_packet(in, inlen, out.data(), out.size(), &consumed);
+        ASSERT_EQ(len, frame.size());
+        EXPECT_TRUE(std::equal(frame.begin(), frame.end(), out.begin()));
+        EXPECT_EQ(consumed, reference_encode(frame).size());
+        EXPECT_EQ(in[consumed - 1], END);
+        in += consumed;
+        inlen -= consumed;
+    }
+    EXPECT_EQ(inlen, 0u);
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketExConsumed) {
+    const uint8_t in[] = {0x01, ESC, ESCEND, 0x02, END, 0x03, END};
+    size_t consumed = 0;
+    Result<size_t> res = decode_packet_ex(in, sizeof(in), buffer.data(), buffer.size(), &consumed);
+    ASSERT_TRUE(res.is_success());
+    EXPECT_EQ(res.value, 3u);
+    EXPECT_EQ(consumed, 5u);
+    res = decode_packet_ex(in + consumed, sizeof(in) - consumed, buffer.data(), buffer.size(), &consumed);
+    ASSERT_TRUE(res.is_success());
+    EXPECT_EQ(res.value, 1u);
+    EXPECT_EQ(consumed, 2u);
+    // nullptr is allowed
+    EXPECT_EQ(decode_packet(in, sizeof(in), buffer.data(), buffer.size(), nullptr), 3u);
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketConsumedUnchangedOnError) {
+    const uint8_t incomplete[] = {0x01, 0x02, 0x03};
+    size_t consumed = 12345;
+    EXPECT_EQ(decode_packet(incomplete, sizeof(incomplete), buffer.data(), buffer.size(), &consumed), DECODE_ERROR);
+    EXPECT_EQ(consumed, 12345u);
+    Result<size_t> res = decode_packet_ex(incomplete, sizeof(incomplete), buffer.data(), buffer.size(), &consumed);
+    EXPECT_EQ(res.error.code, ErrorCode::DecodeNoEndMarker);
+    EXPECT_EQ(consumed, 12345u);
+}
+
+// ============================================================================
+// Batch decoding into a frame index
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, DecodeAllPacketsBuildsFrameIndex) {
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<uint8_t> stream = {END}; // Leading END (empty frame) is skipped
+    for (size_t len : {1u, 5u, 40u, 100u, 3u}) {
+        payloads.push_back(make_test_payload(len, 7));
+        std::vector<uint8_t> encoded = reference_encode(payloads.back());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    std::vector<uint8_t> arena(stream.size());
+    FrameRef frames[8];
+    size_t consumed = 0;
+    size_t n = decode_all_packets(stream.data(), stream.size(), arena.data(), arena.size(), frames, 8, &consumed);
+    ASSERT_EQ(n, payloads.size());
+    EXPECT_EQ(consumed, stream.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(frames[i].offset, offset); // Frames are stored back-to-back
+        ASSERT_EQ(frames[i].length, payloads[i].size());
+        EXPECT_EQ(0, std::memcmp(arena.data() + frames[i].offset, payloads[i].data(), frames[i].length));
+        offset += frames[i].length;
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodeAllPacketsStopsAtIncompleteFrame) {
+    const uint8_t stream[] = {0x01, 0x02, END, 0x03, ESC, ESCESC, END, 0x04, 0x05};
+    uint8_t arena[sizeof(stream)];
+    FrameRef frames[4];
+    size_t consumed = 0;
+    ASSERT_EQ(decode_all_packets(stream, sizeof(stream), arena, sizeof(arena), frames, 4, &consumed), 2u);
+    EXPECT_EQ(consumed, 7u); // The incomplete frame {0x04, 0x05} is left for the next call
+    EXPECT_EQ(frames[1].offset, 2u);
+    EXPECT_EQ(frames[1].length, 2u);
+    EXPECT_EQ(arena[3], ESC);
+    // Truncated escape at the end of the input is incomplete as well
+    const uint8_t truncated[] = {0x01, END, 0x02, ESC};
+    ASSERT_EQ(decode_all_packets(truncated, sizeof(truncated), arena, sizeof(arena), frames, 4, &consumed), 1u);
+    EXPECT_EQ(consumed, 2u);
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodeAllPacketsDropsMalformedFrames) {
+    const uint8_t stream[] = {0x01, END, 0x02, ESC, 0x42, 0x03, END, 0x04, END, 0x05, ESC, END, 0x06, END};
+    uint8_t arena[sizeof(stream)];
+    FrameRef frames[4];
+    size_t consumed = 0;
+    ASSERT_EQ(decode_all_packets(stream, sizeof(stream), arena, sizeof(arena), frames, 4, &consumed), 3u);
+    EXPECT_EQ(consumed, sizeof(stream));
+    EXPECT_EQ(arena[frames[0].offset], 0x01);
+    EXPECT_EQ(arena[frames[1].offset], 0x04);
+    EXPECT_EQ(arena[frames[2].offset], 0x06);
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodeAllPacketsLimits) {
+    const uint8_t stream[] = {0x01, END, 0x02, 0x03, END, 0x04, END};
+    uint8_t arena[sizeof(stream)];
+    FrameRef frames[4];
+    size_t consumed = 0;
+    // Frame table full
+    ASSERT_EQ(decode_all_packets(stream, sizeof(stream), arena, sizeof(arena), frames, 1, &consumed), 1u);
+    EXPECT_EQ(consumed, 2u);
+    // Arena full: The second frame does not fit into the one remaining byte
+    ASSERT_EQ(decode_all_packets(stream, sizeof(stream), arena, 2, frames, 4, &consumed), 1u);
+    EXPECT_EQ(consumed, 2u);
+    // Empty input
+    ASSERT_EQ(decode_all_packets(stream, 0, arena, sizeof(arena), frames, 4, nullptr), 0u);
+}
+
+// ============================================================================
+// In-place decoding
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketInplaceMatchesReference) {
+    for (uint32_t every : {0u, 1u, 3u, 17u, 100u}) {
+        for (size_t len = 0; len <= 150; len++) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> encoded = reference_encode(data);
+            encoded.push_back(0x42); // Next frame must not be touched
+            size_t consumed = 0;
+            ASSERT_EQ(decode_packet_inplace(encoded.data(), encoded.size(), &consumed), len);
+            EXPECT_EQ(consumed, encoded.size() - 1);
+            EXPECT_TRUE(std::equal(data.begin(), data.end(), encoded.begin())) << "len=" << len << " every=" << every;
+            EXPECT_EQ(encoded.back(), 0x42);
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketInplaceErrors) {
+    uint8_t invalid[] = {0x01, ESC, ESCEND, ESC, 0x42, END};
+    Result<size_t> res = decode_packet_inplace_ex(invalid, sizeof(invalid));
+    EXPECT_EQ(res.error.code, ErrorCode::DecodeInvalidEscapeSequence);
+    EXPECT_EQ(res.error.position, 2u);
+    uint8_t truncated[] = {0x01, ESC};
+    EXPECT_EQ(decode_packet_inplace_ex(truncated, sizeof(truncated)).error.code, ErrorCode::DecodeTruncatedEscape);
+    EXPECT_EQ(decode_packet_inplace(truncated, sizeof(truncated)), DECODE_ERROR);
+    uint8_t noend[] = {0x01, 0x02};
+    size_t consumed = 12345;
+    EXPECT_EQ(decode_packet_inplace_ex(noend, sizeof(noend), &consumed).error.code, ErrorCode::DecodeNoEndMarker);
+    EXPECT_EQ(consumed, 12345u);
+}
+
+// ============================================================================
+// Scatter-gather encoding
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketvMatchesConcatenation) {
+    std::vector<uint8_t> header = make_test_payload(7, 3);
+    std::vector<uint8_t> payload = make_test_payload(100, 17);
+    std::vector<uint8_t> trailer = make_test_payload(4, 1);
+    Segment segments[] = {{header.data(), header.size()}, {nullptr, 0}, {payload.data(), payload.size()}, {trailer.data(), trailer.size()}};
+    std::vector<uint8_t> concatenated = header;
+    concatenated.insert(concatenated.end(), payload.begin(), payload.end());
+    concatenated.insert(concatenated.end(), trailer.begin(), trailer.end());
+    std::vector<uint8_t> expected = reference_encode(concatenated);
+
+    EXPECT_EQ(encoded_lengthv(segments, 4), expected.size());
+    std::vector<uint8_t> out(expected.size());
+    ASSERT_EQ(encode_packetv(segments, 4, out.data(), out.size()), expected.size());
+    EXPECT_EQ(out, expected);
+    Result<size_t> res = encode_packetv_ex(segments, 4, out.data(), out.size());
+    ASSERT_TRUE(res.is_success());
+    EXPECT_EQ(out, expected);
+    // No segments at all is an empty packet
+    EXPECT_EQ(encode_packetv(segments, 0, out.data(), out.size()), 1u);
+    EXPECT_EQ(out[0], END);
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketvErrorPositionSpansSegments) {
+    const uint8_t header[] = {0x01, 0x02};
+    const uint8_t payload[] = {0x03, END, 0x04};
+    Segment segments[] = {{header, sizeof(header)}, {payload, sizeof(payload)}};
+    ASSERT_EQ(encoded_lengthv(segments, 2), 7u);
+    for (size_t outlen = 0; outlen < 7; outlen++) {
+        EXPECT_EQ(encode_packetv(segments, 2, buffer.data(), outlen), ENCODE_ERROR) << "outlen=" << outlen;
+    }
+    // 0x01 0x02 0x03 fit, the escaped END (input position 3) does not
+    Result<size_t> res = encode_packetv_ex(segments, 2, buffer.data(), 5);
+    EXPECT_EQ(res.error.code, ErrorCode::EncodeBufferTooSmall);
+    EXPECT_EQ(res.error.position, 3u);
+    EXPECT_STREQ(res.error.message, "Output buffer too small for escaped END");
+}
+
+// ============================================================================
+// Fused encode + CRC32
+// ============================================================================
+
+// Reference: append_crc32() into a copy, then encode_packet()
+static std::vector<uint8_t> reference_encode_crc32(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> with_crc(data.size() + 4);
+    std::copy(data.begin(), data.end(), with_crc.begin());
+    append_crc32(with_crc.data(), data.size());
+    return reference_encode(with_crc);
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketCrc32MatchesAppendThenEncode) {
+    std::vector<size_t> lengths;
+    for (size_t len = 0; len <= 70; len++) {
+        lengths.push_back(len);
+    }
+    // Around the internal block size
+    for (size_t len : {2047u, 2048u, 2049u, 5000u}) {
+        lengths.push_back(len);
+    }
+    for (uint32_t every : {0u, 1u, 17u}) {
+        for (size_t len : lengths) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> expected = reference_encode_crc32(data);
+            std::vector<uint8_t> out(max_encoded_length_crc32(len));
+            ASSERT_EQ(encode_packet_crc32(data.data(), data.size(), out.data(), out.size()), expected.size());
+            out.resize(expected.size());
+            EXPECT_EQ(out, expected) << "len=" << len << " every=" << every;
+            // The exact length is sufficient as well
+            Result<size_t> res = encode_packet_crc32_ex(data.data(), data.size(), out.data(), out.size());
+            ASSERT_TRUE(res.is_success());
+            EXPECT_EQ(out, expected) << "len=" << len << " every=" << every;
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketCrc32EscapesCrcBytes) {
+    // Find a payload whose CRC contains an END or ESC byte
+    std::vector<uint8_t> data(2);
+    bool found = false;
+    for (uint32_t i = 0; i < 65536 && !found; i++) {
+        data[0] = static_cast<uint8_t>(i);
+        data[1] = static_cast<uint8_t>(i >> 8);
+        uint32_t crc = calculate_crc32(data.data(), data.size());
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint8_t b = static_cast<uint8_t>(crc >> shift);
+            found = found || b == END || b == ESC;
+        }
+    }
+    ASSERT_TRUE(found);
+    std::vector<uint8_t> expected = reference_encode_crc32(data);
+    EXPECT_GT(expected.size(), data.size() + 5);
+    ASSERT_EQ(encode_packet_crc32(data.data(), data.size(), buffer.data(), buffer.size()), expected.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin()));
+}
+
+TEST_F(SLIPBufferEnhancedTest, EncodePacketCrc32RejectsShortOutput) {
+    const uint8_t input[] = {0x01, 0x02, 0x03};
+    // 3 data bytes + 4 CRC bytes (no escapes for this input) + END
+    std::vector<uint8_t> expected = reference_encode_crc32(std::vector<uint8_t>(input, input + 3));
+    ASSERT_EQ(expected.size(), 8u);
+    for (size_t outlen = 0; outlen < expected.size(); outlen++) {
+        EXPECT_EQ(encode_packet_crc32(input, sizeof(input), buffer.data(), outlen), ENCODE_ERROR) << "outlen=" << outlen;
+    }
+    // The data fits, but the CRC trailer does not: positions >= inlen refer to the trailer
+    Result<size_t> res = encode_packet_crc32_ex(input, sizeof(input), buffer.data(), 5);
+    EXPECT_EQ(res.error.code, ErrorCode::EncodeBufferTooSmall);
+    EXPECT_EQ(res.error.position, 4u);
+    res = encode_packet_crc32_ex(input, sizeof(input), buffer.data(), 2);
+    EXPECT_EQ(res.error.position, 1u);
+}
+
+// ============================================================================
+// Fused decode + CRC32 verification
+// ============================================================================
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketCrc32RoundTrip) {
+    std::vector<size_t> lengths;
+    for (size_t len = 0; len <= 40; len++) {
+        lengths.push_back(len);
+    }
+    // Escape sequences split by the internal block size
+    for (size_t len : {1020u, 1023u, 1024u, 2047u, 2048u, 2049u, 6000u}) {
+        lengths.push_back(len);
+    }
+    for (uint32_t every : {0u, 1u, 2u, 17u}) {
+        for (size_t len : lengths) {
+            std::vector<uint8_t> data = make_test_payload(len, every);
+            std::vector<uint8_t> encoded = reference_encode_crc32(data);
+            encoded.push_back(0x42); // Start of the next frame
+            std::vector<uint8_t> out(len + 4);
+            size_t consumed = 0;
+            ASSERT_EQ(decode_packet_crc32(encoded.data(), encoded.size(), out.data(), out.size(), &consumed), len)
+                << "len=" << len << " every=" << every;
+            EXPECT_EQ(consumed, encoded.size() - 1);
+            EXPECT_TRUE(std::equal(data.begin(), data.end(), out.begin())) << "len=" << len << " every=" << every;
+            Result<size_t> res = decode_packet_crc32_ex(encoded.data(), encoded.size(), out.data(), out.size());
+            ASSERT_TRUE(res.is_success());
+            EXPECT_EQ(res.value, len);
+        }
+    }
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketCrc32DetectsCorruption) {
+    std::vector<uint8_t> data = make_test_payload(100, 17);
+    std::vector<uint8_t> encoded = reference_encode_crc32(data);
+    encoded[10] ^= 0x01;
+    std::vector<uint8_t> out(data.size() + 4);
+    size_t consumed = 0;
+    EXPECT_EQ(decode_packet_crc32(encoded.data(), encoded.size(), out.data(), out.size(), &consumed), DECODE_ERROR);
+    // The frame is complete, so it can be skipped
+    EXPECT_EQ(consumed, encoded.size());
+    Result<size_t> res = decode_packet_crc32_ex(encoded.data(), encoded.size(), out.data(), out.size());
+    EXPECT_EQ(res.error.code, ErrorCode::DecodeCrcMismatch);
+    EXPECT_EQ(res.error.position, data.size());
+}
+
+TEST_F(SLIPBufferEnhancedTest, DecodePacketCrc32Malformed) {
+    uint8_t out[16];
+    size_t consumed = 12345;
+    // Malformed frames report the decode_packet_ex() errors and leave [consumed] unchanged
+    const uint8_t invalid[] = {0x01, 0x02, ESC, 0x42, 0x03, 0x04, 0x05, 0x06, END};
+    Result<size_t> res = decode_packet_crc32_ex(invalid, sizeof(invalid), out, sizeof(out), &consumed);
+    EXPECT_EQ(res.error.code, ErrorCode::DecodeInvalidEscapeSequence);
+    EXPECT_EQ(res.error.position, 2u);
+    EXPECT_EQ(consumed, 12345u);
+    const uint8_t noend[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    EXPECT_EQ(decode_packet_crc32_ex(noend, sizeof(noend), out, sizeof(out)).error.code, ErrorCode::DecodeNoEndMarker);
+    EXPECT_EQ(decode_packet_crc32(noend, sizeof(noend), out, sizeof(out)), DECODE_ERROR);
+    // The output buffer must have room for the CRC trailer as well
+    std::vector<uint8_t> encoded = reference_encode_crc32({0x01, 0x02, 0x03});
+    EXPECT_EQ(decode_packet_crc32_ex(encoded.data(), encoded.size(), out, 6).error.code, ErrorCode::DecodeBufferTooSmall);
+    EXPECT_EQ(decode_packet_crc32(encoded.data(), encoded.size(), out, 7), 3u);
+    // Frames shorter than the CRC trailer
+    const uint8_t tooshort[] = {0x01, 0x02, 0x03, END};
+    EXPECT_EQ(decode_packet_crc32_ex(tooshort, sizeof(tooshort), out, sizeof(out)).error.code, ErrorCode::DecodeCrcMismatch);
+}
@@ -0,0 +1,82 @@
+// Tests for the compile-time CRC engine (SLIPStream/Crc.hpp)
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "SLIPStream/Crc.hpp"
+#include "SLIPStream/CRC32.hpp"
+
+using namespace SLIPStream;
+
+namespace {
+
+// The standard check input of the CRC catalogues
+constexpr uint8_t check_input[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+using Crc8Smbus = Crc<8, 0x07, 0x00, false, false, 0x00>;
+using Crc32IsoHdlc = Crc<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+using Crc32Bzip2 = Crc<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF>;
+using Crc64Xz = Crc<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF>;
+using Crc64Ecma = Crc<64, 0x42F0E1EBA9EA3693, 0, false, false, 0>;
+
+// Everything is evaluated at compile time
+static_assert(Crc16Ccitt::calculate(check_input, sizeof(check_input)) == 0x29B1, "CRC-16/CCITT-FALSE");
+static_assert(Crc32C::calculate(check_input, sizeof(check_input)) == 0xE3069283, "CRC-32C");
+static_assert(Crc32::table[1] == 0x09823B6E, "SLIPStream CRC32 table");
+
+std::vector<uint8_t> make_crc_data(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>((i * 7 + 3) % 251);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(CrcTest, CheckValues) {
+    EXPECT_EQ(Crc8Smbus::calculate(check_input, sizeof(check_input)), 0xF4);
+    EXPECT_EQ(Crc16Ccitt::calculate(check_input, sizeof(check_input)), 0x29B1);
+    EXPECT_EQ(Crc16Kermit::calculate(check_input, sizeof(check_input)), 0x2189);
+    EXPECT_EQ(Crc32IsoHdlc::calculate(check_input, sizeof(check_input)), 0xCBF43926u);
+    EXPECT_EQ(Crc32Bzip2::calculate(check_input, sizeof(check_input)), 0xFC891918u);
+    EXPECT_EQ(Crc32C::calculate(check_input, sizeof(check_input)), 0xE3069283u);
+    EXPECT_EQ(Crc64Xz::calculate(check_input, sizeof(check_input)), 0x995DC9BBDF1939FAull);
+    EXPECT_EQ(Crc64Ecma::calculate(check_input, sizeof(check_input)), 0x6C40DF5F0B497347ull);
+}
+
+TEST(CrcTest, ValueTypeMatchesWidth) {
+    static_assert(std::is_same<Crc8Smbus::value_type, uint8_t>::value, "8 bit");
+    static_assert(std::is_same<Crc16Ccitt::value_type, uint16_t>::value, "16 bit");
+    static_assert(std::is_same<Crc32C::value_type, uint32_t>::value, "32 bit");
+    static_assert(std::is_same<Crc64Xz::value_type, uint64_t>::value, "64 bit");
+    EXPECT_EQ(Crc16Ccitt::mask, 0xFFFF);
+    EXPECT_EQ(Crc16Ccitt::polynomial, 0x1021);
+}
+
+TEST(CrcTest, Crc32AliasMatchesCalculateCrc32) {
+    for (size_t size : {0, 1, 15, 16, 255, 256, 1000, 5000}) {
+        std::vector<uint8_t> data = make_crc_data(size);
+        EXPECT_EQ(Crc32::calculate(data.data(), data.size()), calculate_crc32(data.data(), data.size())) << "size " << size;
+    }
+}
+
+TEST(CrcTest, IncrementalUpdateMatchesOneShot) {
+    std::vector<uint8_t> data = make_crc_data(1000);
+    for (size_t split : {0, 1, 333, 999, 1000}) {
+        Crc32C::value_type crc = Crc32C::initial();
+        crc = Crc32C::update(crc, data.data(), split);
+        crc = Crc32C::update(crc, data.data() + split, data.size() - split);
+        EXPECT_EQ(Crc32C::finalize(crc), Crc32C::calculate(data.data(), data.size())) << "split " << split;
+
+        Crc16Ccitt::value_type crc16 = Crc16Ccitt::initial();
+        crc16 = Crc16Ccitt::update(crc16, data.data(), split);
+        crc16 = Crc16Ccitt::update(crc16, data.data() + split, data.size() - split);
+        EXPECT_EQ(Crc16Ccitt::finalize(crc16), Crc16Ccitt::calculate(data.data(), data.size())) << "split " << split;
+    }
+}
+
+TEST(CrcTest, EmptyDataGivesFinalizedInitialValue) {
+    EXPECT_EQ(Crc32C::calculate(nullptr, 0), 0x00000000u);
+    EXPECT_EQ(Crc16Ccitt::calculate(nullptr, 0), 0xFFFF);
+    EXPECT_EQ(Crc32::calculate(nullptr, 0), 0xFFFFFFFFu);
+}
@@ -1,9 +1,12 @@
 // CRC32 tests for SLIPStream
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <vector>
 #include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Crc.hpp"
+#include "Kernels.hpp" // CRC32 table variants
 
 using namespace SLIPStream;
 
@@ -393,3 +396,259 @@ TEST_F(CRC32Test, ConsistencyDifferentOrder) {
     
     EXPECT_NE(crc1, crc2);
 }
+
+// ============================================================================
+// Slicing-by-8/16 Tests
+// ============================================================================
+
+TEST_F(CRC32Test, KnownValueLargeData) {
+    // Long enough for slicing-by-16, reference values from the byte-wise table loop
+    std::vector<uint8_t> sequential(1024);
+    for (size_t i = 0; i < sequential.size(); i++) {
+        sequential[i] = static_cast<uint8_t>(i % 256);
+    }
+    EXPECT_EQ(calculate_crc32(sequential.data(), sequential.size()), 0x8CEC0EFEu);
+
+    std::vector<uint8_t> data(5000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>((i * 7 + 3) % 251);
+    }
+    EXPECT_EQ(calculate_crc32(data.data(), data.size()), 0x1C33A090u);
+}
+
+TEST_F(CRC32Test, SlicingMatchesBytewise) {
+    std::vector<uint8_t> data(700);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+    }
+    // Feeding one byte at a time always uses the byte-wise loop
+    for (size_t offset : {0u, 1u, 3u}) {
+        uint32_t bytewise = 0xFFFFFFFF;
+        for (size_t len = 0; offset + len <= data.size(); len++) {
+            EXPECT_EQ(calculate_crc32(data.data() + offset, len), bytewise) << "offset=" << offset << " len=" << len;
+            if (offset + len < data.size()) {
+                bytewise = calculate_crc32_with_initial(data.data() + offset + len, 1, bytewise);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Combine & Parallel Tests
+// ============================================================================
+
+TEST_F(CRC32Test, CombineMatchesConcatenation) {
+    std::vector<uint8_t> data(3000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + (i >> 5));
+    }
+    uint32_t expected = calculate_crc32(data.data(), data.size());
+    for (size_t split : {0u, 1u, 4u, 15u, 16u, 17u, 100u, 1500u, 2999u, 3000u}) {
+        uint32_t crc_a = calculate_crc32(data.data(), split);
+        uint32_t crc_b = calculate_crc32(data.data() + split, data.size() - split);
+        EXPECT_EQ(crc32_combine(crc_a, crc_b, data.size() - split), expected) << "split=" << split;
+    }
+}
+
+TEST_F(CRC32Test, CombineIsAssociative) {
+    const uint8_t a[] = {0x01, 0x02, 0x03};
+    const uint8_t b[] = {0xC0, 0xDB};
+    const uint8_t c[] = {0x10, 0x20, 0x30, 0x40, 0x50};
+    uint32_t crc_a = calculate_crc32(a, sizeof(a));
+    uint32_t crc_b = calculate_crc32(b, sizeof(b));
+    uint32_t crc_c = calculate_crc32(c, sizeof(c));
+    uint32_t left = crc32_combine(crc32_combine(crc_a, crc_b, sizeof(b)), crc_c, sizeof(c));
+    uint32_t right = crc32_combine(crc_a, crc32_combine(crc_b, crc_c, sizeof(c)), sizeof(b) + sizeof(c));
+    EXPECT_EQ(left, right);
+    const uint8_t abc[] = {0x01, 0x02, 0x03, 0xC0, 0xDB, 0x10, 0x20, 0x30, 0x40, 0x50};
+    EXPECT_EQ(left, calculate_crc32(abc, sizeof(abc)));
+}
+
+TEST_F(CRC32Test, ParallelMatchesSerial) {
+    // Not a multiple of the chunk size, large enough for several threads
+    std::vector<uint8_t> data((5 << 20) + 12345);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 11));
+    }
+    uint32_t expected = calculate_crc32(data.data(), data.size());
+    for (unsigned threads : {0u, 1u, 2u, 3u, 4u, 16u}) {
+        EXPECT_EQ(calculate_crc32_parallel(data.data(), data.size(), threads), expected) << "threads=" << threads;
+    }
+    // Small inputs
+    EXPECT_EQ(calculate_crc32_parallel(data.data(), 1000, 4), calculate_crc32(data.data(), 1000));
+    EXPECT_EQ(calculate_crc32_parallel(nullptr, 0, 4), calculate_crc32(nullptr, 0));
+}
+
+// ============================================================================
+// CRC-32C Tests
+// ============================================================================
+
+TEST_F(CRC32Test, Crc32cCheckValue) {
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(calculate_crc32c(data, sizeof(data)), 0xE3069283u);
+    EXPECT_EQ(calculate_crc32c(nullptr, 0), 0u);
+    // 32 zero bytes (RFC 3720, B.4)
+    std::vector<uint8_t> zeros(32, 0x00);
+    EXPECT_EQ(calculate_crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);
+}
+
+TEST_F(CRC32Test, Crc32cMatchesCompileTimeEngine) {
+    std::vector<uint8_t> data(30000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+    }
+    for (size_t len : {1u, 7u, 8u, 9u, 767u, 768u, 769u, 5000u, 24575u, 24576u, 24577u, 29999u}) {
+        EXPECT_EQ(calculate_crc32c(data.data() + 1, len), Crc32C::calculate(data.data() + 1, len)) << "len=" << len;
+    }
+}
+
+#if defined(SLIPSTREAM_X86_64)
+TEST_F(CRC32Test, Crc32cSse42SerialMatchesTable) {
+    // The CRC-32C kernel for CPUs with SSE4.2 but without PCLMULQDQ
+    if (!kernel_supported(Kernel::SSE42)) {
+        GTEST_SKIP() << "SSE4.2 not supported";
+    }
+    std::vector<uint8_t> data(30000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+    }
+    for (size_t offset : {0u, 1u, 5u}) {
+        for (size_t len : {0u, 1u, 7u, 8u, 9u, 767u, 768u, 769u, 24576u, 29990u}) {
+            EXPECT_EQ(detail::crc32c_update_sse42_serial(0x12345678u, data.data() + offset, len),
+                      detail::crc32c_update_table(0x12345678u, data.data() + offset, len))
+                << "offset=" << offset << " len=" << len;
+        }
+    }
+}
+#endif
+
+TEST_F(CRC32Test, Crc32cIncremental) {
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + (i >> 5));
+    }
+    uint32_t expected = calculate_crc32c(data.data(), data.size());
+    for (size_t split : {0u, 1u, 8u, 333u, 999u, 1000u}) {
+        uint32_t crc = calculate_crc32c(data.data(), split);
+        EXPECT_EQ(calculate_crc32c_with_initial(data.data() + split, data.size() - split, crc), expected) << "split=" << split;
+    }
+}
+
+TEST_F(CRC32Test, Crc32cAppendExtractVerify) {
+    const uint8_t payload[] = {0x01, 0xC0, 0xDB, 0x7F, 0xFF};
+    std::vector<uint8_t> frame(payload, payload + sizeof(payload));
+    frame.resize(sizeof(payload) + 4);
+    EXPECT_EQ(append_crc32c(frame.data(), sizeof(payload)), sizeof(payload) + 4);
+    uint32_t stored = 0;
+    EXPECT_EQ(extract_crc32c(frame.data(), frame.size(), &stored), sizeof(payload));
+    EXPECT_EQ(stored, calculate_crc32c(payload, sizeof(payload)));
+    EXPECT_TRUE(verify_crc32c(frame.data(), frame.size()));
+    // A CRC32 trailer is not a valid CRC-32C trailer and vice versa
+    EXPECT_FALSE(verify_crc32(frame.data(), frame.size()));
+    frame[2] ^= 0x01;
+    EXPECT_FALSE(verify_crc32c(frame.data(), frame.size()));
+    EXPECT_FALSE(verify_crc32c(nullptr, 8));
+    EXPECT_FALSE(verify_crc32c(frame.data(), 3));
+}
+
+
+// ============================================================================
+// Accumulator Tests
+// ============================================================================
+
+TEST_F(CRC32Test, AccumulatorMatchesOneShot) {
+    std::vector<uint8_t> data(2000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + (i >> 5));
+    }
+    Crc32Accumulator acc;
+    EXPECT_EQ(acc.value(), calculate_crc32(nullptr, 0));
+    // Pieces of varying size, including single bytes
+    size_t pos = 0;
+    for (size_t piece = 0; pos < data.size(); piece++) {
+        size_t n = std::min(piece % 7 == 0 ? size_t(1) : piece * 13, data.size() - pos);
+        if (n == 1) {
+            acc.update(data[pos]);
+        } else {
+            acc.update(data.data() + pos, n);
+        }
+        pos += n;
+        EXPECT_EQ(acc.value(), calculate_crc32(data.data(), pos)) << "pos=" << pos;
+    }
+}
+
+TEST_F(CRC32Test, AccumulatorReset) {
+    const uint8_t data[] = {0x01, 0xC0, 0xDB, 0x7F};
+    Crc32Accumulator acc;
+    acc.update(data, sizeof(data));
+    acc.reset();
+    EXPECT_EQ(acc.value(), 0xFFFFFFFFu);
+    acc.update(data, sizeof(data));
+    EXPECT_EQ(acc.value(), calculate_crc32(data, sizeof(data)));
+    // Custom initial value
+    Crc32Accumulator custom(0x12345678u);
+    custom.update(data, sizeof(data));
+    EXPECT_EQ(custom.value(), calculate_crc32_with_initial(data, sizeof(data), 0x12345678u));
+    custom.reset();
+    EXPECT_EQ(custom.value(), 0x12345678u);
+}
+
+// ============================================================================
+// Batch Tests
+// ============================================================================
+
+TEST_F(CRC32Test, BatchMatchesSingle) {
+    // Mixed lengths, so that lanes run out of common data at different points
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 128, 1500, 7, 64, 64, 64, 48, 3000, 2, 5};
+    std::vector<std::vector<uint8_t>> frames;
+    for (size_t f = 0; f < sizeof(lengths) / sizeof(lengths[0]); f++) {
+        std::vector<uint8_t> frame(lengths[f]);
+        for (size_t i = 0; i < frame.size(); i++) {
+            frame[i] = static_cast<uint8_t>(f * 37 + i * 131 + (i >> 3));
+        }
+        frames.push_back(frame);
+    }
+    std::vector<const uint8_t*> bufs;
+    std::vector<size_t> lens;
+    for (const auto& frame : frames) {
+        bufs.push_back(frame.data());
+        lens.push_back(frame.size());
+    }
+    // Every batch size, including ones which are not a multiple of the number of lanes
+    for (size_t n = 0; n <= frames.size(); n++) {
+        std::vector<uint32_t> crcs(n + 1, 0xDEADBEEF);
+        calculate_crc32_batch(bufs.data(), lens.data(), crcs.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_EQ(crcs[i], calculate_crc32(bufs[i], lens[i])) << "n=" << n << " i=" << i;
+        }
+        EXPECT_EQ(crcs[n], 0xDEADBEEFu) << "n=" << n; // No write past the end
+    }
+}
+
+// ============================================================================
+// Table Variant Tests
+// ============================================================================
+
+TEST_F(CRC32Test, TableVariantsMatch) {
+    // All variants compiled in for the SLIPSTREAM_CRC32_* level of this build
+    std::vector<uint8_t> data(600);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+    }
+    for (size_t len : {0u, 1u, 15u, 16u, 255u, 256u, 599u}) {
+        uint32_t expected = Crc32::update(0x12345678u, data.data() + 1, len);
+        EXPECT_EQ(detail::crc32_update_bitwise(0x12345678u, data.data() + 1, len), expected) << "len=" << len;
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_NIBBLE
+        EXPECT_EQ(detail::crc32_update_nibble(0x12345678u, data.data() + 1, len), expected) << "len=" << len;
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_BYTE
+        EXPECT_EQ(detail::crc32_update_bytewise(0x12345678u, data.data() + 1, len), expected) << "len=" << len;
+#endif
+#if SLIPSTREAM_CRC32_LEVEL >= SLIPSTREAM_CRC32_LEVEL_SLICING
+        EXPECT_EQ(detail::crc32_update_slicing(0x12345678u, data.data() + 1, len), expected) << "len=" << len;
+#endif
+        EXPECT_EQ(detail::crc32_update_table(0x12345678u, data.data() + 1, len), expected) << "len=" << len;
+        EXPECT_EQ(detail::crc32c_update_table(0x12345678u, data.data() + 1, len), Crc32C::update(0x12345678u, data.data() + 1, len)) << "len=" << len;
+    }
+}
+
@@ -5,6 +5,7 @@
 #include <vector>
 #include <functional>
 #include "SLIPStream/Decoder.hpp"
+#include "SLIPStream/Buffer.hpp"
 #include "SLIPStream/SLIP.hpp"
 
 using namespace SLIPStream;
@@ -269,6 +270,7 @@ TEST(SLIPDecoderEnhanced, GetLastErrorAfterError) {
     ErrorInfo error = dec.getLastError();
     // The error should be set after the invalid escape sequence
     EXPECT_TRUE(result.has_error);
+    EXPECT_EQ(error.code, ErrorCode::DecodeInvalidEscapeSequence);
 }
 
 TEST(SLIPDecoderEnhanced, GetLastErrorAfterReset) {
@@ -450,3 +452,194 @@ TEST(SLIPDecoderEnhanced, LegacyLogCallbackStillWorks) {
     EXPECT_FALSE(log_types.empty());
     EXPECT_EQ(log_types.back(), LogType::RXBufferOverflow);
 }
+
+// ============================================================================
+// In-place mode
+// ============================================================================
+
+TEST(SLIPDecoderEnhanced, ConsumeInplaceDeliversFramesWithinBuffer) {
+    std::vector<uint8_t*> pointers;
+    MessageCapture capture;
+    std::vector<uint8_t> rxbuf(4); // Frames larger than the RX buffer are fine in place
+    Decoder dec(rxbuf.data(), rxbuf.size(),
+        [&](uint8_t* data, size_t size) { pointers.push_back(data); capture.callback(data, size); },
+        [](LogInfo) {});
+
+    uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, END, ESC, ESCEND, 0x07, ESC, ESCESC, END};
+    dec.consume_inplace(data, sizeof(data));
+
+    ASSERT_EQ(capture.messages.size(), 2u);
+    EXPECT_EQ(capture.messages[0], (std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04, 0x05, 0x06}));
+    EXPECT_EQ(capture.messages[1], (std::vector<uint8_t>{END, 0x07, ESC}));
+    // Messages point into the caller's buffer, not into the RX buffer
+    EXPECT_EQ(pointers[0], data);
+    EXPECT_EQ(pointers[1], data + 7);
+}
+
+TEST(SLIPDecoderEnhanced, ConsumeInplaceCarriesPartialFrames) {
+    MessageCapture capture;
+    std::vector<uint8_t> rxbuf(64);
+    Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(), [](LogInfo) {});
+
+    // Frame split across calls, including in the middle of an escape sequence
+    uint8_t first[] = {0x01, END, 0x02, ESC};
+    uint8_t second[] = {ESCEND, 0x03, END, 0x04};
+    uint8_t third[] = {END};
+    dec.consume_inplace(first, sizeof(first));
+    ASSERT_EQ(capture.messages.size(), 1u);
+    dec.consume_inplace(second, sizeof(second));
+    ASSERT_EQ(capture.messages.size(), 2u);
+    EXPECT_EQ(capture.messages[1], (std::vector<uint8_t>{0x02, END, 0x03}));
+    dec.consume_inplace(third, sizeof(third));
+    ASSERT_EQ(capture.messages.size(), 3u);
+    EXPECT_EQ(capture.messages[2], (std::vector<uint8_t>{0x04}));
+}
+
+TEST(SLIPDecoderEnhanced, ConsumeInplaceSkipsInvalidEscape) {
+    MessageCapture capture;
+    std::vector<uint8_t> rxbuf(64);
+    Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(), [](LogInfo) {});
+
+    // Like consume(): The bytes up to and including the invalid escape sequence are dropped
+    uint8_t data[] = {0x01, ESC, ESCEND, ESC, 0x42, 0x02, END, 0x03, END};
+    dec.consume_inplace(data, sizeof(data));
+    ASSERT_EQ(capture.messages.size(), 2u);
+    EXPECT_EQ(capture.messages[0], (std::vector<uint8_t>{0x02}));
+    EXPECT_EQ(capture.messages[1], (std::vector<uint8_t>{0x03}));
+    EXPECT_EQ(dec.getLastError().code, ErrorCode::DecodeInvalidEscapeSequence);
+}
+
+TEST(SLIPDecoderEnhanced, ConsumeInplaceReportsLikeConsume) {
+    // Valid frames and frames with invalid escape sequences
+    const std::vector<uint8_t> stream = {0x01, END, 0x02, ESC, 0x42, 0x03, END, 0x04, ESC, ESCEND, END,
+                                         ESC, ESC, END, 0x05, END};
+    // Legacy log callback
+    MessageCapture capture, capture_inplace;
+    std::vector<LogType> log_types, log_types_inplace;
+    std::vector<uint8_t> rxbuf(64), rxbuf_inplace(64);
+    Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(),
+        [&log_types](LogType type, const char*) { log_types.push_back(type); });
+    Decoder dec_inplace(rxbuf_inplace.data(), rxbuf_inplace.size(), capture_inplace.getFn(),
+        [&log_types_inplace](LogType type, const char*) { log_types_inplace.push_back(type); });
+    dec.consume(stream.data(), stream.size());
+    std::vector<uint8_t> buffer = stream;
+    dec_inplace.consume_inplace(buffer.data(), buffer.size());
+    EXPECT_EQ(capture_inplace.messages, capture.messages);
+    EXPECT_EQ(capture.messages.size(), 5u);
+    EXPECT_EQ(log_types_inplace, log_types);
+    EXPECT_EQ(log_types, std::vector<LogType>(2, LogType::InvalidEscapeSequence));
+    EXPECT_EQ(dec_inplace.getLastError().code, dec.getLastError().code);
+    EXPECT_EQ(dec.getLastError().code, ErrorCode::DecodeInvalidEscapeSequence);
+
+    // Enhanced log callback: The positions of in-place errors are relative to the buffer
+    std::vector<LogInfo> entries, entries_inplace;
+    Decoder dec_ex(rxbuf.data(), rxbuf.size(), capture.getFn(),
+        [&entries](LogInfo info) { entries.push_back(info); });
+    Decoder dec_ex_inplace(rxbuf_inplace.data(), rxbuf_inplace.size(), capture_inplace.getFn(),
+        [&entries_inplace](LogInfo info) { entries_inplace.push_back(info); });
+    dec_ex.consume(stream.data(), stream.size());
+    buffer = stream;
+    dec_ex_inplace.consume_inplace(buffer.data(), buffer.size());
+    ASSERT_EQ(entries.size(), 2u);
+    ASSERT_EQ(entries_inplace.size(), 2u);
+    for (size_t i = 0; i < entries.size(); i++) {
+        EXPECT_EQ(entries_inplace[i].error.code, entries[i].error.code);
+        EXPECT_EQ(entries[i].error.code, ErrorCode::DecodeInvalidEscapeSequence);
+    }
+    // The first invalid escape sequence starts at stream[3]
+    EXPECT_EQ(entries_inplace[0].error.position, 3u);
+    EXPECT_EQ(dec_ex_inplace.getLastError().position, entries_inplace[1].error.position);
+}
+
+// ============================================================================
+// CRC mode
+// ============================================================================
+
+// Encode [payload] + CRC32 + END and append it to [stream]
+static void append_crc32_frame(std::vector<uint8_t>& stream, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame(max_encoded_length_crc32(payload.size()));
+    frame.resize(encode_packet_crc32(payload.data(), payload.size(), frame.data(), frame.size()));
+    stream.insert(stream.end(), frame.begin(), frame.end());
+}
+
+TEST(SLIPDecoderEnhanced, CheckCrc32ValidCorruptedAndMalformedFrames) {
+    const std::vector<uint8_t> first = {0x01, END, 0x02, ESC, 0x03};
+    const std::vector<uint8_t> second = {0x10, 0x20};
+    std::vector<uint8_t> stream = {END}; // Leading END: ignored
+    append_crc32_frame(stream, first);
+    size_t corrupted = stream.size();
+    append_crc32_frame(stream, second);
+    stream[corrupted] ^= 0x01; // CRC error
+    stream.insert(stream.end(), {0x01, ESC, 0x42, END}); // Malformed
+    append_crc32_frame(stream, second);
+
+    for (bool useEx : {false, true}) {
+        MessageCapture capture;
+        std::vector<uint8_t> rxbuf(64);
+        std::vector<LogInfo> log_entries;
+        Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(),
+            [&log_entries](LogInfo info) { log_entries.push_back(info); });
+        EXPECT_FALSE(dec.checksCrc32());
+        dec.setCheckCrc32(true);
+        EXPECT_TRUE(dec.checksCrc32());
+        size_t crcErrors = 0;
+        for (uint8_t b : stream) {
+            if (useEx) {
+                Decoder::ConsumeResult result = dec.consume_ex(b);
+                crcErrors += (result.has_error && result.error.code == ErrorCode::DecodeCrcMismatch) ? 1 : 0;
+            } else {
+                dec.consume(b);
+            }
+        }
+        // Only the valid frames are delivered, without their CRC
+        ASSERT_EQ(capture.messages.size(), 2u);
+        EXPECT_EQ(capture.messages[0], first);
+        EXPECT_EQ(capture.messages[1], second);
+        // The corrupted frame, then the malformed frame
+        ASSERT_EQ(log_entries.size(), 2u);
+        EXPECT_EQ(log_entries[0].error.code, ErrorCode::DecodeCrcMismatch);
+        EXPECT_EQ(log_entries[1].error.code, ErrorCode::DecodeInvalidEscapeSequence);
+        if (useEx) {
+            EXPECT_EQ(crcErrors, 1u);
+        }
+    }
+}
+
+TEST(SLIPDecoderEnhanced, CheckCrc32LegacyLogCallback) {
+    MessageCapture capture;
+    std::vector<uint8_t> rxbuf(64);
+    std::vector<LogType> log_types;
+    Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(),
+        [&log_types](LogType type, const char*) { log_types.push_back(type); });
+    dec.setCheckCrc32(true);
+    const uint8_t tooshort[] = {0x01, 0x02, END};
+    dec.consume(tooshort, sizeof(tooshort));
+    EXPECT_TRUE(capture.messages.empty());
+    ASSERT_EQ(log_types.size(), 1u);
+    EXPECT_EQ(log_types[0], LogType::CrcMismatch);
+    EXPECT_EQ(dec.getLastError().code, ErrorCode::DecodeCrcMismatch);
+}
+
+TEST(SLIPDecoderEnhanced, CheckCrc32ConsumeInplace) {
+    const std::vector<uint8_t> first = {0x01, END, 0x02};
+    const std::vector<uint8_t> second = {ESC, 0x03, 0x04, 0x05, 0x06};
+    std::vector<uint8_t> stream;
+    append_crc32_frame(stream, first);
+    size_t corrupted = stream.size();
+    append_crc32_frame(stream, second);
+    append_crc32_frame(stream, second);
+    stream[corrupted] ^= 0x01;
+
+    MessageCapture capture;
+    std::vector<uint8_t> rxbuf(64);
+    Decoder dec(rxbuf.data(), rxbuf.size(), capture.getFn(), [](LogInfo) {});
+    dec.setCheckCrc32(true);
+    // Split in the middle of the last frame, which is completed using the RX buffer
+    dec.consume_inplace(stream.data(), stream.size() - 3);
+    ASSERT_EQ(capture.messages.size(), 1u);
+    EXPECT_EQ(capture.messages[0], first);
+    EXPECT_EQ(dec.getLastError().code, ErrorCode::DecodeCrcMismatch);
+    dec.consume_inplace(stream.data() + stream.size() - 3, 3);
+    ASSERT_EQ(capture.messages.size(), 2u);
+    EXPECT_EQ(capture.messages[1], second);
+}
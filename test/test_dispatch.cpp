@@ -0,0 +1,219 @@
+// Runtime kernel dispatch tests for SLIPStream
+// Every kernel supported by the CPU running the tests is checked against
+// a byte-by-byte reference implementation.
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "SLIPStream/SLIP.hpp"
+#include "SLIPStream/Buffer.hpp"
+#include "SLIPStream/CRC32.hpp"
+#include "SLIPStream/Dispatch.hpp"
+
+using namespace SLIPStream;
+
+static std::vector<uint8_t> dispatch_reference_encode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    for (uint8_t b : data) {
+        if (b == END) {
+            out.push_back(ESC);
+            out.push_back(ESCEND);
+        } else if (b == ESC) {
+            out.push_back(ESC);
+            out.push_back(ESCESC);
+        } else {
+            out.push_back(b);
+        }
+    }
+    out.push_back(END);
+    return out;
+}
+
+static std::vector<uint8_t> dispatch_test_payload(size_t len, uint32_t special_every) {
+    std::vector<uint8_t> data(len);
+    for (size_t i = 0; i < len; i++) {
+        uint32_t r = static_cast<uint32_t>(i * 2654435761u + len);
+        uint8_t b = static_cast<uint8_t>(r >> 8);
+        if (b == END || b == ESC) {
+            b = 0x42;
+        }
+        if (special_every != 0 && (r % special_every) == 0) {
+            b = (r & 0x100) ? END : ESC;
+        }
+        data[i] = b;
+    }
+    return data;
+}
+
+class DispatchTest : public ::testing::TestWithParam<Kernel> {
+protected:
+    void SetUp() override {
+        if (!kernel_supported(GetParam())) {
+            GTEST_SKIP() << kernel_name(GetParam()) << " is not supported on this CPU";
+        }
+        ASSERT_TRUE(force_kernel(GetParam()));
+        ASSERT_EQ(active_kernel(), GetParam());
+    }
+
+    void TearDown() override {
+        force_kernel(Kernel::Auto);
+    }
+};
+
+TEST_P(DispatchTest, EncodeMatchesReference) {
+    for (uint32_t every : {0u, 1u, 2u, 5u, 31u, 100u}) {
+        for (size_t len = 0; len <= 300; len++) {
+            std::vector<uint8_t> data = dispatch_test_payload(len, every);
+            std::vector<uint8_t> expected = dispatch_reference_encode(data);
+            ASSERT_EQ(encoded_length(data.data(), data.size()), expected.size());
+            std::vector<uint8_t> out(expected.size());
+            ASSERT_EQ(encode_packet(data.data(), data.size(), out.data(), out.size()), expected.size());
+            EXPECT_EQ(out, expected) << "len=" << len << " every=" << every;
+        }
+    }
+}
+
+TEST_P(DispatchTest, EncodeRejectsShortOutput) {
+    std::vector<uint8_t> data = dispatch_test_payload(150, 7);
+    size_t needed = encoded_length(data.data(), data.size());
+    std::vector<uint8_t> out(needed);
+    for (size_t outlen = 0; outlen < needed; outlen++) {
+        EXPECT_EQ(encode_packet(data.data(), data.size(), out.data(), outlen), ENCODE_ERROR) << "outlen=" << outlen;
+        EXPECT_TRUE(encode_packet_ex(data.data(), data.size(), out.data(), outlen).is_error()) << "outlen=" << outlen;
+    }
+}
+
+TEST_P(DispatchTest, DecodeMatchesReference) {
+    for (uint32_t every : {0u, 1u, 2u, 5u, 31u, 100u}) {
+        for (size_t len = 0; len <= 300; len++) {
+            std::vector<uint8_t> data = dispatch_test_payload(len, every);
+            std::vector<uint8_t> encoded = dispatch_reference_encode(data);
+            ASSERT_EQ(decoded_length(encoded.data(), encoded.size()), len);
+            std::vector<uint8_t> out(len);
+            ASSERT_EQ(decode_packet(encoded.data(), encoded.size(), out.data(), out.size()), len);
+            EXPECT_EQ(out, data) << "len=" << len << " every=" << every;
+            if (len > 0) {
+                Result<size_t> res = decode_packet_ex(encoded.data(), encoded.size(), out.data(), len - 1);
+                EXPECT_EQ(res.error.code, ErrorCode::DecodeBufferTooSmall) << "len=" << len;
+            }
+        }
+    }
+}
+
+TEST_P(DispatchTest, DecodeStopsAtInvalidEscape) {
+    std::vector<uint8_t> data = dispatch_test_payload(200, 0);
+    std::vector<uint8_t> encoded = dispatch_reference_encode(data);
+    std::vector<uint8_t> out(data.size());
+    for (size_t pos = 0; pos < data.size(); pos++) {
+        std::vector<uint8_t> invalid = encoded;
+        invalid[pos] = ESC;
+        invalid[pos + 1] = 0x42;
+        Result<size_t> res = decode_packet_ex(invalid.data(), invalid.size(), out.data(), out.size());
+        EXPECT_EQ(res.error.code, ErrorCode::DecodeInvalidEscapeSequence) << "pos=" << pos;
+        EXPECT_EQ(res.error.position, pos) << "pos=" << pos;
+    }
+}
+
+TEST_P(DispatchTest, CRC32MatchesScalar) {
+    std::vector<uint8_t> data = dispatch_test_payload(1000, 0);
+    std::vector<uint32_t> crcs;
+    for (size_t len = 0; len <= data.size(); len += 37) {
+        crcs.push_back(calculate_crc32(data.data(), len));
+    }
+    ASSERT_TRUE(force_kernel(Kernel::Scalar));
+    for (size_t len = 0, i = 0; len <= data.size(); len += 37, i++) {
+        EXPECT_EQ(crcs[i], calculate_crc32(data.data(), len)) << "len=" << len;
+    }
+}
+
+TEST_P(DispatchTest, CRC32LargeUnalignedWithInitialValue) {
+    // Every length around the 16 byte blocks and the 64 byte folding loop
+    std::vector<uint8_t> data = dispatch_test_payload(4200, 0);
+    std::vector<size_t> lengths;
+    for (size_t len = 0; len <= 300; len++) {
+        lengths.push_back(len);
+    }
+    for (size_t len : {1023u, 1024u, 1025u, 4096u, 4199u}) {
+        lengths.push_back(len);
+    }
+    std::vector<uint32_t> crcs;
+    for (size_t len : lengths) {
+        crcs.push_back(calculate_crc32_with_initial(data.data() + 1, len, 0x12345678u + static_cast<uint32_t>(len)));
+    }
+    ASSERT_TRUE(force_kernel(Kernel::Scalar));
+    for (size_t i = 0; i < lengths.size(); i++) {
+        size_t len = lengths[i];
+        EXPECT_EQ(crcs[i], calculate_crc32_with_initial(data.data() + 1, len, 0x12345678u + static_cast<uint32_t>(len))) << "len=" << len;
+    }
+}
+
+TEST_P(DispatchTest, CRC32CMatchesScalar) {
+    // Lengths around the short (3 x 256 bytes) and long (3 x 8192 bytes) interleaved blocks,
+    // the payload covers the longest length at the largest offset
+    std::vector<uint8_t> data = dispatch_test_payload(3 * 8192 * 2 + 999 + 3, 0);
+    std::vector<size_t> lengths;
+    for (size_t len = 0; len <= 80; len++) {
+        lengths.push_back(len);
+    }
+    for (size_t len : {767u, 768u, 769u, 1536u, 24575u, 24576u, 24577u, 3 * 8192u * 2 + 999u}) {
+        lengths.push_back(len);
+    }
+    std::vector<uint32_t> crcs;
+    for (size_t offset : {0u, 3u}) {
+        for (size_t len : lengths) {
+            crcs.push_back(calculate_crc32c_with_initial(data.data() + offset, len, 0x12345678u + static_cast<uint32_t>(len)));
+        }
+    }
+    ASSERT_TRUE(force_kernel(Kernel::Scalar));
+    size_t i = 0;
+    for (size_t offset : {0u, 3u}) {
+        for (size_t len : lengths) {
+            EXPECT_EQ(crcs[i++], calculate_crc32c_with_initial(data.data() + offset, len, 0x12345678u + static_cast<uint32_t>(len)))
+                << "offset=" << offset << " len=" << len;
+        }
+    }
+}
+
+TEST_P(DispatchTest, CRC32BatchMatchesSingle) {
+    // Unaligned buffers of equal and of different lengths
+    std::vector<uint8_t> data = dispatch_test_payload(4096, 0);
+    for (size_t len : {16u, 48u, 64u, 200u, 1000u}) {
+        const uint8_t* bufs[5] = {data.data() + 1, data.data() + 700, data.data() + 1403, data.data() + 2100, data.data() + 3000};
+        size_t lens[5] = {len, len, len + 5, len, len + 17};
+        uint32_t crcs[5];
+        calculate_crc32_batch(bufs, lens, crcs, 5);
+        for (size_t i = 0; i < 5; i++) {
+            EXPECT_EQ(crcs[i], calculate_crc32(bufs[i], lens[i])) << "len=" << len << " i=" << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllKernels, DispatchTest,
+    ::testing::Values(Kernel::Scalar, Kernel::SWAR, Kernel::SSE42, Kernel::AVX2),
+    [](const ::testing::TestParamInfo<Kernel>& info) { return std::string(kernel_name(info.param)); });
+
+TEST(DispatchSelectionTest, AutoSelectsBestSupported) {
+    ASSERT_TRUE(force_kernel(Kernel::Auto));
+    EXPECT_EQ(active_kernel(), best_supported_kernel());
+    EXPECT_TRUE(kernel_supported(best_supported_kernel()));
+}
+
+TEST(DispatchSelectionTest, PortableKernelsAlwaysSupported) {
+    EXPECT_TRUE(kernel_supported(Kernel::Scalar));
+    EXPECT_TRUE(kernel_supported(Kernel::SWAR));
+}
+
+TEST(DispatchSelectionTest, ForceUnsupportedKernelKeepsActive) {
+    ASSERT_TRUE(force_kernel(Kernel::Scalar));
+    EXPECT_FALSE(force_kernel(static_cast<Kernel>(42)));
+    EXPECT_EQ(active_kernel(), Kernel::Scalar);
+    force_kernel(Kernel::Auto);
+}
+
+TEST(DispatchSelectionTest, KernelNames) {
+    EXPECT_STREQ(kernel_name(Kernel::Scalar), "scalar");
+    EXPECT_STREQ(kernel_name(Kernel::SWAR), "swar");
+    EXPECT_STREQ(kernel_name(Kernel::SSE42), "sse42");
+    EXPECT_STREQ(kernel_name(Kernel::AVX2), "avx2");
+}
@@ -1,11 +1,13 @@
 // Comprehensive tests for Encoder class with enhanced error reporting
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <vector>
 #include <deque>
 #include <functional>
 #include "SLIPStream/Encoder.hpp"
+#include "SLIPStream/Buffer.hpp"
 #include "SLIPStream/SLIP.hpp"
 
 using namespace SLIPStream;
@@ -43,6 +45,23 @@ struct ErrorSink {
     void reset() { out.clear(); accepted = 0; }
 };
 
+// Helper: bulk sink recording every call, accepting at most [maxPerCall] bytes per call
+struct RecordingBulkSink {
+    std::vector<uint8_t> out;
+    std::vector<size_t> callLengths; // Offered length of every call
+    size_t maxPerCall = SIZE_MAX;
+    size_t budget = SIZE_MAX; // Total bytes to accept before blocking
+    WriteStatus status = WriteStatus::Ok;
+
+    std::pair<WriteStatus, size_t> operator()(const uint8_t* data, size_t length) {
+        callLengths.push_back(length);
+        size_t n = std::min(std::min(length, maxPerCall), budget);
+        out.insert(out.end(), data, data + n);
+        budget -= n;
+        return {status, n};
+    }
+};
+
 class SLIPEncoderEnhancedTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -149,8 +168,8 @@ TEST(SLIPEncoderEnhanced, PushPacketExRetryLater) {
     
     EXPECT_TRUE(result.is_retry());
     EXPECT_EQ(result.status, WriteStatus::RetryLater);
-    EXPECT_GT(result.consumed, 0u);
-    EXPECT_LT(result.consumed, sizeof(in));
+    // The packet fits into one maxSendChunk window: queued before the sink blocks
+    EXPECT_EQ(result.consumed, sizeof(in));
 }
 
 TEST(SLIPEncoderEnhanced, PushPacketExErrorFromOutput) {
@@ -319,3 +338,572 @@ TEST(SLIPEncoderEnhanced, EndPendingState) {
         EXPECT_TRUE(result2.is_success() || result2.is_retry());
     }
 }
+
+// ============================================================================
+// Scatter-gather packets
+// ============================================================================
+
+TEST(SLIPEncoderEnhanced, PushPacketvMatchesConcatenation) {
+    const uint8_t header[] = {0x01, END};
+    const uint8_t payload[] = {0x02, ESC, 0x03};
+    const uint8_t trailer[] = {0x04};
+    Segment segments[] = {{header, sizeof(header)}, {nullptr, 0}, {payload, sizeof(payload)}, {trailer, sizeof(trailer)}};
+
+    BackpressuredSink sink;
+    Encoder enc([&sink](uint8_t b){ return sink(b); }, 64, 64);
+    auto [status, consumed] = enc.pushPacketv(segments, 4);
+    EXPECT_EQ(status, WriteStatus::Ok);
+    EXPECT_EQ(consumed, 6u);
+    std::vector<uint8_t> expected = {0x01, ESC, ESCEND, 0x02, ESC, ESCESC, 0x03, 0x04, END};
+    EXPECT_EQ(sink.out, expected);
+
+    sink.reset();
+    Encoder::PushPacketResult result = enc.pushPacketv_ex(segments, 4);
+    EXPECT_TRUE(result.is_success());
+    EXPECT_EQ(result.consumed, 6u);
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, PushPacketvRetryReportsConsumedAcrossSegments) {
+    const uint8_t header[] = {0x01, 0x02, 0x03};
+    const uint8_t payload[] = {0x04, 0x05, 0x06};
+    Segment segments[] = {{header, sizeof(header)}, {payload, sizeof(payload)}};
+
+    BackpressuredSink sink;
+    sink.acceptThenBlock = 4;
+    Encoder enc([&sink](uint8_t b){ return sink(b); }, 64, 64);
+    auto [status, consumed] = enc.pushPacketv(segments, 2);
+    EXPECT_EQ(status, WriteStatus::RetryLater);
+    // Both segments fit into one maxSendChunk window and have been queued before the sink blocked
+    EXPECT_EQ(consumed, 6u);
+    EXPECT_EQ(sink.out.size(), 4u);
+}
+
+TEST(SLIPEncoderEnhanced, AppendCrc32MatchesEncodePacketCrc32) {
+    std::vector<uint8_t> payload(300);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 7);
+    }
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+
+    BackpressuredSink sink;
+    Encoder enc([&sink](uint8_t b){ return sink(b); }, 64, 64);
+    EXPECT_FALSE(enc.appendsCrc32());
+    enc.setAppendCrc32(true);
+    EXPECT_TRUE(enc.appendsCrc32());
+    // Two packets: the CRC restarts for every packet
+    for (int packet = 0; packet < 2; packet++) {
+        sink.reset();
+        auto [status, consumed] = enc.pushPacket(payload.data(), payload.size());
+        EXPECT_EQ(status, WriteStatus::Ok);
+        EXPECT_EQ(consumed, payload.size());
+        EXPECT_EQ(sink.out, expected) << "packet=" << packet;
+    }
+    sink.reset();
+    Encoder::PushPacketResult result = enc.pushPacket_ex(payload.data(), payload.size());
+    EXPECT_TRUE(result.is_success());
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, AppendCrc32ResumesAfterRetryLater) {
+    const uint8_t payload[] = {0x10, END, 0x20, ESC, 0x30, 0x40};
+    std::vector<uint8_t> expected(max_encoded_length_crc32(sizeof(payload)));
+    expected.resize(encode_packet_crc32(payload, sizeof(payload), expected.data(), expected.size()));
+
+    // Block at every possible position, including inside the CRC trailer
+    for (size_t block = 0; block < expected.size(); block++) {
+        BackpressuredSink sink;
+        sink.acceptThenBlock = block;
+        Encoder enc([&sink](uint8_t b){ return sink(b); }, 4, 64);
+        enc.setAppendCrc32(true);
+        size_t offset = 0;
+        for (int attempt = 0; attempt < 100; attempt++) {
+            auto [status, consumed] = enc.pushPacket(payload + offset, sizeof(payload) - offset);
+            offset += consumed;
+            if (status == WriteStatus::Ok) {
+                break;
+            }
+            ASSERT_EQ(status, WriteStatus::RetryLater);
+            sink.acceptThenBlock = SIZE_MAX;
+            if (offset == sizeof(payload)) {
+                break; // Only the trailer is left, flush() completes it
+            }
+        }
+        do {
+            ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+        } while (enc.queued() > 0);
+        EXPECT_EQ(sink.out, expected) << "block=" << block;
+    }
+}
+
+// ============================================================================
+// Bulk output tests
+// ============================================================================
+
+TEST(SLIPEncoderEnhanced, BulkOutputMatchesPerByteOutput) {
+    std::vector<uint8_t> payload(500);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 13);
+    }
+    BackpressuredSink byteSink;
+    Encoder byteEnc([&byteSink](uint8_t b){ return byteSink(b); }, 64, 16);
+    RecordingBulkSink bulkSink;
+    Encoder bulkEnc([&bulkSink](const uint8_t* data, size_t length){ return bulkSink(data, length); }, 64, 16);
+    for (int packet = 0; packet < 3; packet++) {
+        EXPECT_EQ(byteEnc.pushPacket(payload.data(), payload.size()).first, WriteStatus::Ok);
+        EXPECT_EQ(bulkEnc.pushPacket(payload.data(), payload.size()).first, WriteStatus::Ok);
+    }
+    while (byteEnc.queued() > 0) {
+        byteEnc.flush();
+    }
+    while (bulkEnc.queued() > 0) {
+        bulkEnc.flush();
+    }
+    EXPECT_EQ(bulkSink.out, byteSink.out);
+    // No call exceeds maxSendChunk
+    EXPECT_LE(*std::max_element(bulkSink.callLengths.begin(), bulkSink.callLengths.end()), 16u);
+}
+
+TEST(SLIPEncoderEnhanced, BulkOutputFlushesContiguousRuns) {
+    RecordingBulkSink sink;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 16, 64);
+    enc.setMaxSendChunk(0); // Only queue
+    const uint8_t first[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    enc.pushPacket(first, sizeof(first));
+    ASSERT_EQ(enc.queued(), sizeof(first) + 1);
+    enc.setMaxSendChunk(64);
+    ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+    // Queue a packet which wraps around the end of the ring
+    enc.setMaxSendChunk(0);
+    const uint8_t second[] = {11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    enc.pushPacket(second, sizeof(second));
+    ASSERT_EQ(enc.queued(), sizeof(second) + 1);
+    sink.callLengths.clear();
+    enc.setMaxSendChunk(64);
+    EXPECT_EQ(enc.flush(), WriteStatus::Ok);
+    EXPECT_EQ(enc.queued(), 0u);
+    // One call up to the end of the ring, one for the rest
+    ASSERT_EQ(sink.callLengths.size(), 2u);
+    EXPECT_EQ(sink.callLengths[0] + sink.callLengths[1], sizeof(second) + 1);
+}
+
+TEST(SLIPEncoderEnhanced, BulkOutputPartialWritesAndErrors) {
+    RecordingBulkSink sink;
+    sink.maxPerCall = 3;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 64, 0);
+    const uint8_t payload[] = {1, END, 2, ESC, 3, 4, 5, 6};
+    enc.pushPacket(payload, sizeof(payload));
+    size_t queued = enc.queued();
+    ASSERT_EQ(queued, max_encoded_length(sizeof(payload)) - 6);
+    enc.setMaxSendChunk(64);
+    // Short write: flush reports RetryLater and keeps the rest
+    EXPECT_EQ(enc.flush(), WriteStatus::RetryLater);
+    EXPECT_EQ(enc.queued(), queued - 3);
+    // Error with partial write
+    sink.budget = SIZE_MAX;
+    sink.status = WriteStatus::Error;
+    WriteResult result = enc.flush_ex();
+    EXPECT_TRUE(result.is_error());
+    EXPECT_EQ(result.error.code, ErrorCode::EncodeInternalError);
+    EXPECT_EQ(result.error.position, 3u);
+    // Recovered output: the remaining bytes follow
+    sink.status = WriteStatus::Ok;
+    while (enc.queued() > 0) {
+        EXPECT_FALSE(enc.flush_ex().is_error());
+    }
+    std::vector<uint8_t> expected(max_encoded_length(sizeof(payload)));
+    expected.resize(encode_packet(payload, sizeof(payload), expected.data(), expected.size()));
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, BulkEncodeMatchesEncodePacket) {
+    std::vector<uint8_t> payload(1000);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>((i * 37) ^ (i >> 3));
+        if (i % 13 == 0) payload[i] = END;
+        if (i % 17 == 0) payload[i] = ESC;
+    }
+    for (bool crc : {false, true}) {
+        std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+        expected.resize(crc ? encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size())
+                            : encode_packet(payload.data(), payload.size(), expected.data(), expected.size()));
+        for (size_t bufferSize : {2, 5, 64, 1500}) {
+            for (size_t chunk : {1, 3, 64, 4096}) {
+                // Short writes make the encoder return RetryLater in the middle of runs
+                RecordingBulkSink sink;
+                sink.maxPerCall = 29;
+                Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, bufferSize, chunk);
+                enc.setAppendCrc32(crc);
+                size_t offset = 0;
+                for (int attempt = 0; attempt < 100000; attempt++) {
+                    auto [status, consumed] = enc.pushPacket(payload.data() + offset, payload.size() - offset);
+                    offset += consumed;
+                    if (status == WriteStatus::Ok) {
+                        break;
+                    }
+                    ASSERT_EQ(status, WriteStatus::RetryLater);
+                    if (offset == payload.size()) {
+                        break; // Only the trailer is left, flush() completes it
+                    }
+                }
+                do {
+                    ASSERT_NE(enc.flush(), WriteStatus::Error); // Short writes: RetryLater
+                } while (enc.queued() > 0);
+                EXPECT_EQ(sink.out, expected) << "crc=" << crc << " buffer=" << bufferSize << " chunk=" << chunk;
+            }
+        }
+    }
+}
+
+TEST(SLIPEncoderEnhanced, BulkEncodeFlushesOncePerWindow) {
+    std::vector<uint8_t> payload(4096, 0x42);
+    RecordingBulkSink sink;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 8192, 1024);
+    auto [status, consumed] = enc.pushPacket(payload.data(), payload.size());
+    EXPECT_EQ(status, WriteStatus::Ok);
+    EXPECT_EQ(consumed, payload.size());
+    // One output call per maxSendChunk window instead of one flush per byte
+    EXPECT_EQ(sink.callLengths, std::vector<size_t>(4, 1024));
+    // The END did not fit into the last window
+    EXPECT_EQ(enc.queued(), 1u);
+    EXPECT_EQ(enc.flush(), WriteStatus::Ok);
+    EXPECT_EQ(sink.out.size(), payload.size() + 1);
+    EXPECT_EQ(sink.out.back(), END);
+}
+
+// ============================================================================
+// Zero-copy readable_segments() / consume() tests
+// ============================================================================
+
+namespace {
+
+// Take all queued bytes out of the encoder like writev() would
+std::vector<uint8_t> drain(Encoder& enc) {
+    Encoder::ReadableSegments segments = enc.readable_segments();
+    std::vector<uint8_t> out(segments.first.data, segments.first.data + segments.first.length);
+    out.insert(out.end(), segments.second.data, segments.second.data + segments.second.length);
+    EXPECT_EQ(enc.consume(segments.total()), segments.total());
+    return out;
+}
+
+} // namespace
+
+TEST(SLIPEncoderEnhanced, ReadableSegmentsQueueOnly) {
+    Encoder enc(64);
+    Encoder::ReadableSegments empty = enc.readable_segments();
+    EXPECT_EQ(empty.total(), 0u);
+    const uint8_t payload[] = {0x01, END, 0x02, ESC, 0x03};
+    EXPECT_EQ(enc.flush(), WriteStatus::Ok); // Nothing to do
+    auto [status, consumed] = enc.pushPacket(payload, sizeof(payload));
+    EXPECT_EQ(status, WriteStatus::Ok);
+    EXPECT_EQ(consumed, sizeof(payload));
+    Encoder::ReadableSegments segments = enc.readable_segments();
+    EXPECT_EQ(segments.total(), enc.queued());
+    EXPECT_EQ(segments.second.length, 0u);
+    std::vector<uint8_t> expected(max_encoded_length(sizeof(payload)));
+    expected.resize(encode_packet(payload, sizeof(payload), expected.data(), expected.size()));
+    EXPECT_EQ(drain(enc), expected);
+    EXPECT_EQ(enc.queued(), 0u);
+}
+
+TEST(SLIPEncoderEnhanced, ReadableSegmentsWrapAround) {
+    Encoder enc(16);
+    const uint8_t payload[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    enc.pushPacket(payload, sizeof(payload));
+    // Partially consume, so the next packet wraps around the end of the ring
+    EXPECT_EQ(enc.consume(8), 8u);
+    enc.pushPacket(payload, sizeof(payload));
+    Encoder::ReadableSegments segments = enc.readable_segments();
+    EXPECT_EQ(segments.first.length, 8u);
+    EXPECT_EQ(segments.second.length, 6u);
+    std::vector<uint8_t> expected = {9, 10, END, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, END};
+    EXPECT_EQ(drain(enc), expected);
+    // Consuming more than queued only removes what is there
+    EXPECT_EQ(enc.consume(5), 0u);
+}
+
+TEST(SLIPEncoderEnhanced, ReadableSegmentsResumeWhenFull) {
+    std::vector<uint8_t> payload(100);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 5);
+    }
+    std::vector<uint8_t> expected(max_encoded_length(payload.size()));
+    expected.resize(encode_packet(payload.data(), payload.size(), expected.data(), expected.size()));
+    // The queue is smaller than the packet: drain it whenever pushPacket() runs out of space
+    Encoder enc(16);
+    std::vector<uint8_t> out;
+    size_t offset = 0;
+    for (int attempt = 0; attempt < 100; attempt++) {
+        auto [status, consumed] = enc.pushPacket(payload.data() + offset, payload.size() - offset);
+        offset += consumed;
+        std::vector<uint8_t> chunk = drain(enc);
+        out.insert(out.end(), chunk.begin(), chunk.end());
+        if (status == WriteStatus::Ok) {
+            break;
+        }
+        ASSERT_EQ(status, WriteStatus::RetryLater);
+    }
+    EXPECT_EQ(out, expected);
+}
+
+// ============================================================================
+// Streaming packet builder: beginPacket() / append() / endPacket()
+// ============================================================================
+
+TEST(SLIPEncoderEnhanced, StreamingPacketMatchesEncodePacket) {
+    std::vector<uint8_t> payload(500);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 13);
+    }
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+
+    RecordingBulkSink sink;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 1024, 1024);
+    enc.setAppendCrc32(true);
+    // Two packets streamed in pieces of different sizes: ONE frame each
+    for (size_t piece : {1, 37}) {
+        sink.out.clear();
+        EXPECT_EQ(enc.beginPacket(), WriteStatus::Ok);
+        EXPECT_TRUE(enc.packetOpen());
+        for (size_t offset = 0; offset < payload.size(); offset += piece) {
+            size_t n = std::min(piece, payload.size() - offset);
+            auto [status, consumed] = enc.append(payload.data() + offset, n);
+            ASSERT_EQ(status, WriteStatus::Ok);
+            ASSERT_EQ(consumed, n);
+        }
+        EXPECT_EQ(enc.endPacket(), WriteStatus::Ok);
+        EXPECT_FALSE(enc.packetOpen());
+        EXPECT_EQ(sink.out, expected) << "piece=" << piece;
+    }
+}
+
+TEST(SLIPEncoderEnhanced, StreamingPacketResumesAfterRetryLater) {
+    const uint8_t first[] = {0x01, END, 0x02, ESC, 0x03, 0x04, 0x05, 0x06, 0x07};
+    const uint8_t second[] = {ESC, ESC, 0x08, 0x09, END, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    std::vector<uint8_t> payload(first, first + sizeof(first));
+    payload.insert(payload.end(), second, second + sizeof(second));
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+
+    // The queue is too small for the packet: drain it whenever a call returns RetryLater
+    Encoder enc(6);
+    enc.setAppendCrc32(true);
+    std::vector<uint8_t> out;
+    auto drain = [&enc, &out]() {
+        Encoder::ReadableSegments segments = enc.readable_segments();
+        out.insert(out.end(), segments.first.data, segments.first.data + segments.first.length);
+        out.insert(out.end(), segments.second.data, segments.second.data + segments.second.length);
+        enc.consume(segments.total());
+    };
+    ASSERT_EQ(enc.beginPacket(), WriteStatus::Ok);
+    for (const std::vector<uint8_t>& piece : {std::vector<uint8_t>(first, first + sizeof(first)),
+                                             std::vector<uint8_t>(second, second + sizeof(second))}) {
+        size_t offset = 0;
+        int retries = 0;
+        while (offset < piece.size()) {
+            auto [status, consumed] = enc.append(piece.data() + offset, piece.size() - offset);
+            offset += consumed;
+            if (status == WriteStatus::RetryLater) {
+                retries++;
+                drain();
+            } else {
+                ASSERT_EQ(status, WriteStatus::Ok);
+            }
+        }
+        EXPECT_GT(retries, 0);
+    }
+    // The CRC trailer and END don't fit at once either
+    WriteStatus st;
+    while ((st = enc.endPacket()) == WriteStatus::RetryLater) {
+        drain();
+    }
+    EXPECT_EQ(st, WriteStatus::Ok);
+    drain();
+    EXPECT_EQ(out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, PushPacketChunkEncodesOnePacket) {
+    const uint8_t payload[] = {0x01, END, 0x02, ESC, 0x03, 0x04, 0x05};
+    std::vector<uint8_t> expected(max_encoded_length(sizeof(payload)));
+    expected.resize(encode_packet(payload, sizeof(payload), expected.data(), expected.size()));
+    RecordingBulkSink sink;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 64, 64);
+    auto [status, consumed] = enc.pushPacket_chunk(payload, sizeof(payload), 3);
+    EXPECT_EQ(status, WriteStatus::Ok);
+    EXPECT_EQ(consumed, sizeof(payload));
+    EXPECT_EQ(sink.out, expected);
+    sink.out.clear();
+    Encoder::PushPacketResult result = enc.pushPacket_chunk_ex(payload, sizeof(payload), 2);
+    EXPECT_TRUE(result.is_success());
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, PushPacketChunkResumesAfterRetryLater) {
+    std::vector<uint8_t> payload(60);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 7);
+        if (i % 9 == 0) payload[i] = END;
+    }
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+
+    RecordingBulkSink sink;
+    sink.budget = 0; // Output blocked
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 16, 8);
+    enc.setAppendCrc32(true);
+    auto [status, offset] = enc.pushPacket_chunk(payload.data(), payload.size(), 5);
+    ASSERT_EQ(status, WriteStatus::RetryLater);
+    ASSERT_LT(offset, payload.size());
+    // The packet stays open: pushPacket() is rejected until it is resumed
+    EXPECT_TRUE(enc.packetOpen());
+    EXPECT_EQ(enc.pushPacket_ex(payload.data(), payload.size()).error.code, ErrorCode::EncodeInvalidPacketState);
+    for (int attempt = 0; attempt < 1000 && status == WriteStatus::RetryLater && offset < payload.size(); attempt++) {
+        sink.budget = 10;
+        auto [st, consumed] = enc.pushPacket_chunk(payload.data() + offset, payload.size() - offset, 5);
+        status = st;
+        offset += consumed;
+    }
+    ASSERT_NE(status, WriteStatus::Error);
+    EXPECT_EQ(offset, payload.size());
+    EXPECT_FALSE(enc.packetOpen());
+    // Only the trailer may be left
+    sink.budget = SIZE_MAX;
+    do {
+        ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+    } while (enc.queued() > 0);
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, StreamingPacketStateErrors) {
+    RecordingBulkSink sink;
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 64, 64);
+    const uint8_t payload[] = {0x01, 0x02};
+    // append() without beginPacket()
+    EXPECT_EQ(enc.append(payload, sizeof(payload)).first, WriteStatus::Error);
+    Encoder::PushPacketResult result = enc.append_ex(payload, sizeof(payload));
+    EXPECT_TRUE(result.is_error());
+    EXPECT_EQ(result.error.code, ErrorCode::EncodeInvalidPacketState);
+    // beginPacket() and pushPacket() while a packet is open
+    EXPECT_EQ(enc.beginPacket(), WriteStatus::Ok);
+    EXPECT_EQ(enc.beginPacket(), WriteStatus::Error);
+    EXPECT_EQ(enc.beginPacket_ex().error.code, ErrorCode::EncodeInvalidPacketState);
+    EXPECT_EQ(enc.pushPacket(payload, sizeof(payload)).first, WriteStatus::Error);
+    EXPECT_EQ(enc.pushPacket_ex(payload, sizeof(payload)).error.code, ErrorCode::EncodeInvalidPacketState);
+    EXPECT_TRUE(enc.append_ex(payload, sizeof(payload)).is_success());
+    EXPECT_TRUE(enc.endPacket_ex().is_success());
+    // endPacket() without an open packet
+    EXPECT_EQ(enc.endPacket(), WriteStatus::Error);
+    EXPECT_EQ(enc.endPacket_ex().error.code, ErrorCode::EncodeInvalidPacketState);
+    // The packet is unaffected by the rejected calls
+    std::vector<uint8_t> expected = {0x01, 0x02, END};
+    EXPECT_EQ(sink.out, expected);
+}
+
+// ============================================================================
+// Atomic enqueue mode
+// ============================================================================
+
+TEST(SLIPEncoderEnhanced, AtomicEnqueueWholeFrameOrNothing) {
+    const uint8_t first[] = {0x01, END, 0x02, ESC, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    const uint8_t second[] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F};
+    Encoder enc(24);
+    EXPECT_FALSE(enc.enqueuesAtomically());
+    enc.setAtomicEnqueue(true);
+    EXPECT_TRUE(enc.enqueuesAtomically());
+    auto [status1, consumed1] = enc.pushPacket(first, sizeof(first));
+    EXPECT_EQ(status1, WriteStatus::Ok);
+    EXPECT_EQ(consumed1, sizeof(first));
+    EXPECT_EQ(enc.queued(), encoded_length(first, sizeof(first)));
+    // Does not fit completely: nothing is queued
+    auto [status2, consumed2] = enc.pushPacket(second, sizeof(second));
+    EXPECT_EQ(status2, WriteStatus::RetryLater);
+    EXPECT_EQ(consumed2, 0u);
+    EXPECT_EQ(enc.queued(), encoded_length(first, sizeof(first)));
+    // Take the first frame out of the queue, then the second one fits
+    std::vector<uint8_t> out = drain(enc);
+    Encoder::PushPacketResult result = enc.pushPacket_ex(second, sizeof(second));
+    EXPECT_TRUE(result.is_success());
+    EXPECT_EQ(result.consumed, sizeof(second));
+    std::vector<uint8_t> rest = drain(enc);
+    out.insert(out.end(), rest.begin(), rest.end());
+
+    std::vector<uint8_t> expected(max_encoded_length(sizeof(first)) + max_encoded_length(sizeof(second)));
+    size_t len = encode_packet(first, sizeof(first), expected.data(), expected.size());
+    len += encode_packet(second, sizeof(second), expected.data() + len, expected.size() - len);
+    expected.resize(len);
+    EXPECT_EQ(out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, AtomicEnqueueCrc32ExactFit) {
+    std::vector<uint8_t> payload(40);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i * 11);
+    }
+    std::vector<uint8_t> expected(max_encoded_length_crc32(payload.size()));
+    expected.resize(encode_packet_crc32(payload.data(), payload.size(), expected.data(), expected.size()));
+    // The queue has room for exactly one frame
+    Encoder enc(expected.size());
+    enc.setAtomicEnqueue(true);
+    enc.setAppendCrc32(true);
+    EXPECT_EQ(enc.pushPacket(payload.data(), payload.size()).first, WriteStatus::Ok);
+    EXPECT_EQ(enc.free(), 0u);
+    auto [status, consumed] = enc.pushPacket(payload.data(), payload.size());
+    EXPECT_EQ(status, WriteStatus::RetryLater);
+    EXPECT_EQ(consumed, 0u);
+    EXPECT_EQ(drain(enc), expected);
+    // The CRC restarts after a rejected frame
+    EXPECT_EQ(enc.pushPacket(payload.data(), payload.size()).first, WriteStatus::Ok);
+    EXPECT_EQ(drain(enc), expected);
+}
+
+TEST(SLIPEncoderEnhanced, AtomicEnqueuePushPacketChunk) {
+    const uint8_t first[] = {0x01, END, 0x02, ESC, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    const uint8_t second[] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F};
+    Encoder enc(24);
+    enc.setAtomicEnqueue(true);
+    EXPECT_EQ(enc.pushPacket_chunk(first, sizeof(first), 4).first, WriteStatus::Ok);
+    // Does not fit completely: nothing is queued and no packet stays open
+    auto [status, consumed] = enc.pushPacket_chunk(second, sizeof(second), 4);
+    EXPECT_EQ(status, WriteStatus::RetryLater);
+    EXPECT_EQ(consumed, 0u);
+    EXPECT_FALSE(enc.packetOpen());
+    EXPECT_EQ(enc.queued(), encoded_length(first, sizeof(first)));
+    // Can never fit
+    const std::vector<uint8_t> large(30, 0x01);
+    Encoder::PushPacketResult result = enc.pushPacket_chunk_ex(large.data(), large.size(), 4);
+    EXPECT_EQ(result.error.code, ErrorCode::EncodeBufferTooSmall);
+    std::vector<uint8_t> out = drain(enc);
+    EXPECT_TRUE(enc.pushPacket_chunk_ex(second, sizeof(second), 4).is_success());
+    std::vector<uint8_t> rest = drain(enc);
+    out.insert(out.end(), rest.begin(), rest.end());
+
+    std::vector<uint8_t> expected(max_encoded_length(sizeof(first)) + max_encoded_length(sizeof(second)));
+    size_t len = encode_packet(first, sizeof(first), expected.data(), expected.size());
+    len += encode_packet(second, sizeof(second), expected.data() + len, expected.size() - len);
+    expected.resize(len);
+    EXPECT_EQ(out, expected);
+}
+
+TEST(SLIPEncoderEnhanced, AtomicEnqueueFrameLargerThanQueue) {
+    RecordingBulkSink sink;
+    sink.budget = 0; // Output blocked
+    Encoder enc([&sink](const uint8_t* data, size_t length){ return sink(data, length); }, 8, 64);
+    enc.setAtomicEnqueue(true);
+    const uint8_t small[] = {0x01, 0x02, 0x03};
+    const uint8_t large[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    // Queued even though the output blocks
+    EXPECT_EQ(enc.pushPacket(small, sizeof(small)).first, WriteStatus::Ok);
+    EXPECT_EQ(enc.queued(), sizeof(small) + 1);
+    EXPECT_EQ(enc.pushPacket(large, sizeof(large)).first, WriteStatus::Error);
+    Encoder::PushPacketResult result = enc.pushPacket_ex(large, sizeof(large));
+    EXPECT_TRUE(result.is_error());
+    EXPECT_EQ(result.error.code, ErrorCode::EncodeBufferTooSmall);
+    EXPECT_EQ(result.consumed, 0u);
+    EXPECT_EQ(enc.queued(), sizeof(small) + 1);
+    sink.budget = SIZE_MAX;
+    EXPECT_EQ(enc.flush(), WriteStatus::Ok);
+    std::vector<uint8_t> expected = {0x01, 0x02, 0x03, END};
+    EXPECT_EQ(sink.out, expected);
+}
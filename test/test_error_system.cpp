@@ -7,8 +7,10 @@ using namespace SLIPStream;
 TEST(ErrorSystem, ErrorCodeToString) {
     EXPECT_STREQ(error_code_to_string(ErrorCode::Success), "Success");
     EXPECT_STREQ(error_code_to_string(ErrorCode::EncodeBufferTooSmall), "EncodeBufferTooSmall");
+    EXPECT_STREQ(error_code_to_string(ErrorCode::EncodeInvalidPacketState), "EncodeInvalidPacketState");
     EXPECT_STREQ(error_code_to_string(ErrorCode::DecodeNoEndMarker), "DecodeNoEndMarker");
     EXPECT_STREQ(error_code_to_string(ErrorCode::DecodeInvalidEscapeSequence), "DecodeInvalidEscapeSequence");
+    EXPECT_STREQ(error_code_to_string(ErrorCode::DecodeCrcMismatch), "DecodeCrcMismatch");
     EXPECT_STREQ(error_code_to_string(ErrorCode::RXBufferOverflow), "RXBufferOverflow");
     EXPECT_STREQ(error_code_to_string(ErrorCode::UnknownError), "UnknownError");
 }
@@ -67,25 +67,37 @@ TEST(SLIPEncoder, RetryLaterDuringEncode) {
     // First push: will encode until sink blocks
     auto [st1, cons1] = enc.pushPacket(in, sizeof(in));
     EXPECT_EQ(st1, WriteStatus::RetryLater);
-    // cons1 should be > 0 but < sizeof(in)
-    EXPECT_GT(cons1, 0u);
-    EXPECT_LT(cons1, sizeof(in));
-    // Make sink accept more and try again
+    // The packet fits into one maxSendChunk window, so all of it is queued before the sink blocks
+    EXPECT_EQ(cons1, sizeof(in));
+    // Make sink accept more: With the whole payload consumed, flush() sends the rest
     sink.acceptThenBlock = SIZE_MAX; // never block now
+    do {
+        ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+    } while (enc.queued() > 0);
+    // Exactly one frame
+    std::vector<uint8_t> expected = {0x01, ESC, ESCEND, 0x02, END};
+    EXPECT_EQ(sink.out, expected);
+}
+
+TEST(SLIPEncoder, RetryLaterResumeWithRestOfPayload) {
+    BackpressuredSink sink;
+    sink.acceptThenBlock = 3;
+    // The queue is too small for the packet: pushPacket() returns before consuming all of it
+    Encoder enc([&sink](uint8_t b){ return sink(b); }, 4, 4);
+    const uint8_t in[] = {0x01, END, 0x02, ESC, 0x03, 0x04, 0x05};
+    auto [st1, cons1] = enc.pushPacket(in, sizeof(in));
+    EXPECT_EQ(st1, WriteStatus::RetryLater);
+    ASSERT_LT(cons1, sizeof(in));
+    // Resume with the rest of the payload, then drain
+    sink.acceptThenBlock = SIZE_MAX;
     auto [st2, cons2] = enc.pushPacket(in + cons1, sizeof(in) - cons1);
-    EXPECT_EQ(st2, WriteStatus::Ok);
-    EXPECT_EQ(cons2 + cons1, sizeof(in));
-    // Now flush should have been done; content in sink.out should form a complete packet
-    // We may have flush interleavings; just verify decoded payload matches original
-    // Decode by iterating
-    std::vector<uint8_t> decoded;
-    for (uint8_t b : sink.out) {
-        if (b == END) break;
-        if (b == ESC) continue; // simplified: next byte will be ESCEND/ESCESC
-    }
-    // Instead, check for presence of END at end
-    ASSERT_FALSE(sink.out.empty());
-    EXPECT_EQ(sink.out.back(), END);
+    EXPECT_NE(st2, WriteStatus::Error);
+    EXPECT_EQ(cons1 + cons2, sizeof(in));
+    do {
+        ASSERT_EQ(enc.flush(), WriteStatus::Ok);
+    } while (enc.queued() > 0);
+    std::vector<uint8_t> expected = {0x01, ESC, ESCEND, 0x02, ESC, ESCESC, 0x03, 0x04, 0x05, END};
+    EXPECT_EQ(sink.out, expected);
 }
 
 TEST(SLIPEncoder, QueueCapacityAndFragmentation) {